@@ -0,0 +1,69 @@
+#include <Eigen/Core>
+#include <algorithm>
+#include <benchmark/benchmark.h>
+
+#include "basisSplines/basis.h"
+#include "benchBase.h"
+
+namespace BasisSplines {
+namespace Internal {
+
+/**
+ * @brief Create a basis of order 4 with "numKnots" clustered random knots.
+ *
+ * @param numKnots number of knots.
+ * @return Basis basis with non-uniform knots.
+ */
+Basis clusteredBasis(int numKnots) {
+  Eigen::ArrayXd knots{Eigen::ArrayXd::Random(numKnots).pow(3)};
+  std::sort(knots.begin(), knots.end());
+  return {knots, 4};
+}
+
+/**
+ * @brief Look up knot spans by scanning all knots.
+ *
+ */
+static void BasisSpanScan(benchmark::State &state) {
+  const Basis basis{clusteredBasis(static_cast<int>(state.range(0)))};
+  const Eigen::ArrayXd points{Eigen::ArrayXd::Random(1000)};
+
+  for (auto _ : state)
+    for (double point : points)
+      benchmark::DoNotOptimize(
+          std::find_if(basis.knots().begin(), basis.knots().end(),
+                       [&](double knot) { return knot >= point; }));
+}
+BENCHMARK(BasisSpanScan)->RangeMultiplier(100)->Range(1000, 100000);
+
+/**
+ * @brief Look up knot spans by binary search.
+ *
+ */
+static void BasisSpanBinary(benchmark::State &state) {
+  const Basis basis{clusteredBasis(static_cast<int>(state.range(0)))};
+  const Eigen::ArrayXd points{Eigen::ArrayXd::Random(1000)};
+
+  for (auto _ : state)
+    for (double point : points)
+      benchmark::DoNotOptimize(basis.getSpan(point));
+}
+BENCHMARK(BasisSpanBinary)->RangeMultiplier(100)->Range(1000, 100000);
+
+/**
+ * @brief Look up knot spans with the span index.
+ *
+ */
+static void BasisSpanIndex(benchmark::State &state) {
+  Basis basis{clusteredBasis(static_cast<int>(state.range(0)))};
+  basis.setSpanIndex();
+  const Eigen::ArrayXd points{Eigen::ArrayXd::Random(1000)};
+
+  for (auto _ : state)
+    for (double point : points)
+      benchmark::DoNotOptimize(basis.getSpan(point));
+}
+BENCHMARK(BasisSpanIndex)->RangeMultiplier(100)->Range(1000, 100000);
+
+}; // namespace Internal
+}; // namespace BasisSplines
@@ -0,0 +1,59 @@
+#include <Eigen/Core>
+#include <benchmark/benchmark.h>
+
+#include "basisSplines/cpuDispatch.h"
+#include "basisSplines/math.h"
+#include "basisSplines/spline.h"
+#include "benchBase.h"
+
+namespace BasisSplines {
+namespace Internal {
+
+/**
+ * @brief Evaluate a spline of order 4 at 10000 unsorted points span by span
+ * with the instruction set level given by the first argument.
+ *
+ */
+static void CpuDispatchEvalSorted(benchmark::State &state) {
+  const Isa isa{static_cast<Isa>(state.range(0))};
+  if (isa > CpuDispatch::getSupported()) {
+    state.SkipWithError("Instruction set level not supported.");
+    return;
+  }
+  CpuDispatch::setActive(isa);
+  state.SetLabel(CpuDispatch::getName(isa));
+
+  const Spline spline{randomSpline(4, 20, 3)};
+  const Eigen::ArrayXd points{0.5 * Eigen::ArrayXd::Random(10000) + 0.5};
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(spline.evalSorted(points));
+  CpuDispatch::setActive(CpuDispatch::getSupported());
+}
+BENCHMARK(CpuDispatchEvalSorted)->DenseRange(0, 2);
+
+/**
+ * @brief Determine the Khatri-Rao product of two 1000 x 10 matrices with the
+ * instruction set level given by the first argument.
+ *
+ */
+static void CpuDispatchKhatriRao(benchmark::State &state) {
+  const Isa isa{static_cast<Isa>(state.range(0))};
+  if (isa > CpuDispatch::getSupported()) {
+    state.SkipWithError("Instruction set level not supported.");
+    return;
+  }
+  CpuDispatch::setActive(isa);
+  state.SetLabel(CpuDispatch::getName(isa));
+
+  const Eigen::MatrixXd matL{Eigen::MatrixXd::Random(1000, 10)};
+  const Eigen::MatrixXd matR{Eigen::MatrixXd::Random(1000, 10)};
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(khatriRao(matL, matR));
+  CpuDispatch::setActive(CpuDispatch::getSupported());
+}
+BENCHMARK(CpuDispatchKhatriRao)->DenseRange(0, 2);
+
+}; // namespace Internal
+}; // namespace BasisSplines
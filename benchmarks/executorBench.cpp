@@ -0,0 +1,62 @@
+#include <Eigen/Core>
+#include <benchmark/benchmark.h>
+
+#include "basisSplines/executor.h"
+#include "basisSplines/interpolate.h"
+#include "basisSplines/spline.h"
+#include "benchBase.h"
+
+namespace BasisSplines {
+namespace Internal {
+
+/**
+ * @brief Evaluate a spline of order 4 at 100000 points with the number of
+ * threads given by the first argument.
+ *
+ */
+static void ExecutorEvalSorted(benchmark::State &state) {
+  Executor::setNumThreads(static_cast<int>(state.range(0)));
+  const Spline spline{randomSpline(4, 50, 3)};
+  const Eigen::ArrayXd points{0.5 * Eigen::ArrayXd::Random(100000) + 0.5};
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(spline.evalSorted(points));
+  Executor::setNumThreads(0);
+}
+BENCHMARK(ExecutorEvalSorted)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+
+/**
+ * @brief Fit a spline of order 4 with 50 segments to 10000 points with the
+ * number of threads given by the first argument.
+ *
+ */
+static void ExecutorFit(benchmark::State &state) {
+  Executor::setNumThreads(static_cast<int>(state.range(0)));
+  const Spline spline{randomSpline(4, 50, 3)};
+  const Eigen::ArrayXd points{0.5 * Eigen::ArrayXd::Random(10000) + 0.5};
+  const Eigen::MatrixXd values{spline(points)};
+  const Interpolate interp{spline.basis()};
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(interp.fit(values, points.matrix()));
+  Executor::setNumThreads(0);
+}
+BENCHMARK(ExecutorFit)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+
+/**
+ * @brief Determine the roots of a spline of order 4 with 200 segments and 8
+ * outputs with the number of threads given by the first argument.
+ *
+ */
+static void ExecutorRoots(benchmark::State &state) {
+  Executor::setNumThreads(static_cast<int>(state.range(0)));
+  const Spline spline{randomSpline(4, 200, 8)};
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(spline.getRoots());
+  Executor::setNumThreads(0);
+}
+BENCHMARK(ExecutorRoots)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+
+}; // namespace Internal
+}; // namespace BasisSplines
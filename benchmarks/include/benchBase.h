@@ -0,0 +1,38 @@
+#ifndef BENCH_BASE_H
+#define BENCH_BASE_H
+
+#include <Eigen/Core>
+#include <memory>
+
+#include "basisSplines/basis.h"
+#include "basisSplines/spline.h"
+
+namespace BasisSplines {
+namespace Internal {
+
+/**
+ * @brief Create a clamped spline of the given "order" with "numSegments"
+ * uniform segments and random coefficients.
+ *
+ * @param order spline order.
+ * @param numSegments number of polynomial segments.
+ * @param dim spline output dimensionality.
+ * @return Spline random spline.
+ */
+Spline randomSpline(int order, int numSegments, int dim = 1) {
+  const Eigen::ArrayXd breakpoints{
+      Eigen::ArrayXd::LinSpaced(numSegments + 1, 0.0, 1.0)};
+  Eigen::ArrayXi continuities{Eigen::ArrayXi::Constant(numSegments + 1,
+                                                       order - 1)};
+  continuities(0) = 0;
+  continuities(numSegments) = 0;
+
+  const std::shared_ptr<Basis> basis{std::make_shared<Basis>(
+      Basis::toKnots(breakpoints, continuities, order), order)};
+  return {basis, Eigen::MatrixXd::Random(basis->dim(), dim)};
+}
+
+}; // namespace Internal
+}; // namespace BasisSplines
+
+#endif
@@ -0,0 +1,77 @@
+#include <Eigen/Core>
+#include <benchmark/benchmark.h>
+
+#include "basisSplines/monotoneInverse.h"
+#include "basisSplines/spline.h"
+#include "benchBase.h"
+
+namespace BasisSplines {
+namespace Internal {
+
+/**
+ * @brief Create an increasing spline of order 4 with "numSegments" segments.
+ *
+ * @param numSegments number of polynomial segments.
+ * @return Spline increasing spline.
+ */
+Spline increasingSpline(int numSegments) {
+  const Spline spline{randomSpline(4, numSegments)};
+  Eigen::MatrixXd coeffs{spline.getCoefficients().array().abs()};
+  for (int cRow{1}; cRow < coeffs.rows(); ++cRow)
+    coeffs(cRow) += coeffs(cRow - 1);
+  return {spline.basis(), coeffs};
+}
+
+/**
+ * @brief Invert an increasing spline by root finding per query.
+ *
+ */
+static void InverseRoots(benchmark::State &state) {
+  const Spline spline{increasingSpline(static_cast<int>(state.range(0)))};
+  const Eigen::ArrayXd queries{Eigen::ArrayXd::LinSpaced(
+      100, spline.getCoefficients()(0),
+      spline.getCoefficients()(spline.getCoefficients().rows() - 1))};
+
+  for (auto _ : state)
+    for (double query : queries)
+      benchmark::DoNotOptimize(
+          Spline{spline.basis(), spline.getCoefficients().array() - query}
+              .getRoots(0, 10, 1e-10));
+}
+BENCHMARK(InverseRoots)->RangeMultiplier(10)->Range(10, 100);
+
+/**
+ * @brief Invert an increasing spline with the monotone inverse.
+ *
+ */
+static void InverseMonotone(benchmark::State &state) {
+  const Spline spline{increasingSpline(static_cast<int>(state.range(0)))};
+  const Eigen::ArrayXd queries{Eigen::ArrayXd::LinSpaced(
+      100, spline.getCoefficients()(0),
+      spline.getCoefficients()(spline.getCoefficients().rows() - 1))};
+  const MonotoneInverse inverse{spline};
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(inverse(queries));
+}
+BENCHMARK(InverseMonotone)->RangeMultiplier(10)->Range(10, 100);
+
+/**
+ * @brief Invert an increasing spline with the monotone inverse for sorted
+ * queries.
+ *
+ */
+static void InverseMonotoneSorted(benchmark::State &state) {
+  const Spline spline{increasingSpline(static_cast<int>(state.range(0)))};
+  const Eigen::ArrayXd queries{Eigen::ArrayXd::LinSpaced(
+      100, spline.getCoefficients()(0),
+      spline.getCoefficients()(spline.getCoefficients().rows() - 1))};
+  const MonotoneInverse inverse{spline};
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(inverse(queries, true));
+}
+BENCHMARK(InverseMonotoneSorted)->RangeMultiplier(10)->Range(10, 100);
+
+}; // namespace Internal
+}; // namespace BasisSplines
@@ -0,0 +1,86 @@
+#include <Eigen/Core>
+#include <benchmark/benchmark.h>
+#include <cmath>
+
+#include "basisSplines/interpolate.h"
+#include "basisSplines/project.h"
+#include "basisSplines/spline.h"
+#include "benchBase.h"
+
+namespace BasisSplines {
+namespace Internal {
+
+/**
+ * @brief Oscillating process with 20 periods on [0, 1].
+ *
+ * @param points evaluation points.
+ * @return Eigen::MatrixXd process values.
+ */
+static Eigen::MatrixXd process(const Eigen::VectorXd &points) {
+  return Eigen::MatrixXd{(40.0 * M_PI * points.array()).sin()};
+}
+
+/**
+ * @brief Determine the RMS error of the "spline" to the process on a fine
+ * grid.
+ *
+ * @param spline spline fitted to the process.
+ * @return double RMS error.
+ */
+static double errorRms(const Spline &spline) {
+  const Eigen::ArrayXd points{Eigen::ArrayXd::LinSpaced(100001, 0.0, 1.0)};
+  return std::sqrt(
+      (spline(points) - process(points.matrix()).array()).square().mean());
+}
+
+/**
+ * @brief Fit a spline of order 4 to an oscillating process by interpolation
+ * at the Greville sites. The RMS error is reported as counter.
+ *
+ */
+static void FitInterpolate(benchmark::State &state) {
+  const std::shared_ptr<Basis> basis{
+      randomSpline(4, state.range(0)).basis()};
+  const Interpolate interp{basis};
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(interp.fit(process));
+
+  state.counters["errorRms"] = errorRms({basis, interp.fit(process)});
+}
+BENCHMARK(FitInterpolate)->Arg(50)->Arg(500);
+
+/**
+ * @brief Fit a spline of order 4 to an oscillating process by L2 projection
+ * with a factorisation reused for all fits. The RMS error is reported as
+ * counter.
+ *
+ */
+static void FitProject(benchmark::State &state) {
+  const std::shared_ptr<Basis> basis{
+      randomSpline(4, state.range(0)).basis()};
+  const Project project{basis};
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(project.fit(process));
+
+  state.counters["errorRms"] = errorRms({basis, project.fit(process)});
+}
+BENCHMARK(FitProject)->Arg(50)->Arg(500);
+
+/**
+ * @brief Construct a Project including the factorisation of the mass matrix
+ * and fit a spline of order 4 to an oscillating process.
+ *
+ */
+static void FitProjectConstruct(benchmark::State &state) {
+  const std::shared_ptr<Basis> basis{
+      randomSpline(4, state.range(0)).basis()};
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(Project{basis}.fit(process));
+}
+BENCHMARK(FitProjectConstruct)->Arg(50)->Arg(500);
+
+}; // namespace Internal
+}; // namespace BasisSplines
@@ -0,0 +1,45 @@
+#include <Eigen/Core>
+#include <benchmark/benchmark.h>
+
+#include "basisSplines/quantisedSpline.h"
+#include "basisSplines/spline.h"
+#include "benchBase.h"
+
+namespace BasisSplines {
+namespace Internal {
+
+/**
+ * @brief Evaluate a spline of order 4 at unsorted points.
+ *
+ */
+static void QuantisedSplineEval(benchmark::State &state) {
+  const Spline spline{randomSpline(4, static_cast<int>(state.range(0)), 3)};
+  const Eigen::ArrayXd points{0.5 * Eigen::ArrayXd::Random(1000) + 0.5};
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(spline(points));
+  state.counters["bytes"] = (spline.getCoefficients().size() +
+                             spline.basis()->knots().size()) *
+                            sizeof(double);
+}
+BENCHMARK(QuantisedSplineEval)->Arg(100)->Arg(100000);
+
+/**
+ * @brief Evaluate the quantised representation of a spline of order 4 at
+ * unsorted points.
+ *
+ */
+static void QuantisedSplineEvalQuantised(benchmark::State &state) {
+  const Spline spline{randomSpline(4, static_cast<int>(state.range(0)), 3)};
+  const QuantisedSpline quantised{spline};
+  const Eigen::ArrayXd points{0.5 * Eigen::ArrayXd::Random(1000) + 0.5};
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(quantised(points));
+  state.counters["bytes"] = quantised.getBytes();
+  state.counters["maxError"] = quantised.getMaxError();
+}
+BENCHMARK(QuantisedSplineEvalQuantised)->Arg(100)->Arg(100000);
+
+}; // namespace Internal
+}; // namespace BasisSplines
@@ -0,0 +1,71 @@
+#include <Eigen/Core>
+#include <benchmark/benchmark.h>
+#include <memory>
+
+#include "basisSplines/smallSpline.h"
+#include "basisSplines/spline.h"
+#include "benchBase.h"
+
+namespace BasisSplines {
+namespace Internal {
+
+/**
+ * @brief Create a spline of order 4 from knots and coefficients.
+ *
+ */
+static void SmallSplineCreateSpline(benchmark::State &state) {
+  const Spline spline{randomSpline(4, 10, 2)};
+  const Eigen::ArrayXd knots{spline.basis()->knots()};
+  const Eigen::MatrixXd coeffs{spline.getCoefficients()};
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(
+        Spline{std::make_shared<Basis>(knots, 4), coeffs});
+}
+BENCHMARK(SmallSplineCreateSpline);
+
+/**
+ * @brief Create a small spline of order 4 from knots and coefficients.
+ *
+ */
+static void SmallSplineCreateSmall(benchmark::State &state) {
+  const Spline spline{randomSpline(4, 10, 2)};
+  const Eigen::ArrayXd knots{spline.basis()->knots()};
+  const Eigen::MatrixXd coeffs{spline.getCoefficients()};
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(SmallSpline{SmallBasis{knots, 4}, coeffs});
+}
+BENCHMARK(SmallSplineCreateSmall);
+
+/**
+ * @brief Evaluate a spline of order 4 and its derivative at a point.
+ *
+ */
+static void SmallSplineEvalSpline(benchmark::State &state) {
+  const Spline spline{randomSpline(4, 10, 2)};
+  const Eigen::ArrayXd point{{0.37}};
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(spline(point));
+    benchmark::DoNotOptimize(spline.derivative()(point));
+  }
+}
+BENCHMARK(SmallSplineEvalSpline);
+
+/**
+ * @brief Evaluate a small spline of order 4 and its derivative at a point.
+ *
+ */
+static void SmallSplineEvalSmall(benchmark::State &state) {
+  const SmallSpline spline{randomSpline(4, 10, 2)};
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(spline(0.37));
+    benchmark::DoNotOptimize(spline.derivative()(0.37));
+  }
+}
+BENCHMARK(SmallSplineEvalSmall);
+
+}; // namespace Internal
+}; // namespace BasisSplines
@@ -0,0 +1,155 @@
+#include <Eigen/Core>
+#include <benchmark/benchmark.h>
+
+#include "basisSplines/basis.h"
+#include "basisSplines/spline.h"
+#include "basisSplines/transformCache.h"
+#include "benchBase.h"
+
+namespace BasisSplines {
+namespace Internal {
+
+/**
+ * @brief Evaluate a spline of order 4 pointwise on a uniform grid.
+ *
+ */
+static void SplineEvalUniform(benchmark::State &state) {
+  const Spline spline{randomSpline(4, 20)};
+  const int count{static_cast<int>(state.range(0))};
+  const Eigen::ArrayXd points{Eigen::ArrayXd::LinSpaced(count, 0.0, 1.0)};
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(spline(points));
+}
+BENCHMARK(SplineEvalUniform)->RangeMultiplier(10)->Range(100, 10000);
+
+/**
+ * @brief Evaluate a spline of order 4 on a uniform grid by forward
+ * differencing.
+ *
+ */
+static void SplineSampleUniform(benchmark::State &state) {
+  const Spline spline{randomSpline(4, 20)};
+  const int count{static_cast<int>(state.range(0))};
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(
+        spline.sampleUniform(0.0, 1.0 / (count - 1), count));
+}
+BENCHMARK(SplineSampleUniform)->RangeMultiplier(10)->Range(100, 10000);
+
+/**
+ * @brief Evaluate a spline of order 4 at unsorted points with dense basis
+ * values.
+ *
+ */
+static void SplineEvalDenseRandom(benchmark::State &state) {
+  const Spline spline{randomSpline(4, static_cast<int>(state.range(1)), 3)};
+  const Eigen::ArrayXd points{
+      0.5 * Eigen::ArrayXd::Random(state.range(0)) + 0.5};
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(spline.basis()->operator()(points) *
+                             spline.getCoefficients());
+}
+BENCHMARK(SplineEvalDenseRandom)
+    ->ArgsProduct({{8, 32, 128, 1000, 10000}, {20, 200}});
+
+/**
+ * @brief Evaluate a spline of order 4 at unsorted points bucketed by span.
+ *
+ */
+static void SplineEvalSortedRandom(benchmark::State &state) {
+  const Spline spline{randomSpline(4, static_cast<int>(state.range(1)), 3)};
+  const Eigen::ArrayXd points{
+      0.5 * Eigen::ArrayXd::Random(state.range(0)) + 0.5};
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(spline.evalSorted(points));
+}
+BENCHMARK(SplineEvalSortedRandom)
+    ->ArgsProduct({{8, 32, 128, 1000, 10000}, {20, 200}});
+
+/**
+ * @brief Add and multiply splines of order 4 with different bases with and
+ * without the global transform cache.
+ *
+ */
+static void SplineAlgebra(benchmark::State &state) {
+  const Spline splineL{randomSpline(4, 20)};
+  const Spline splineR{randomSpline(4, 15)};
+  TransformCache::global().setCapacity(state.range(0));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(splineL.add(splineR));
+    benchmark::DoNotOptimize(splineL.prod(splineR));
+  }
+
+  TransformCache::global().setCapacity(0);
+  TransformCache::global().clear();
+}
+BENCHMARK(SplineAlgebra)->Arg(0)->Arg(16);
+
+/**
+ * @brief Differentiate a spline of order 4 with 3 output dimensions and 50,
+ * 500 or 5000 segments without and with TransformCache. Cache hits are not
+ * slower than the uncached derivative.
+ *
+ */
+static void SplineDerivativeCache(benchmark::State &state) {
+  const Spline spline{randomSpline(4, static_cast<int>(state.range(1)), 3)};
+  TransformCache::global().setCapacity(state.range(0));
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(spline.derivative());
+
+  TransformCache::global().setCapacity(0);
+  TransformCache::global().clear();
+}
+BENCHMARK(SplineDerivativeCache)
+    ->ArgsProduct({{0, 16}, {50, 500, 5000}});
+
+/**
+ * @brief Differentiate and integrate a spline of order 4 into new splines or
+ * into reused output splines.
+ *
+ */
+static void SplineCalculusInto(benchmark::State &state) {
+  const Spline spline{randomSpline(4, 20, 3)};
+  Spline deriv{};
+  Spline integral{};
+
+  for (auto _ : state) {
+    if (state.range(0)) {
+      spline.derivativeInto(deriv);
+      spline.integralInto(integral);
+    } else {
+      deriv = spline.derivative();
+      integral = spline.integral();
+    }
+    benchmark::DoNotOptimize(deriv.getCoefficients().data());
+    benchmark::DoNotOptimize(integral.getCoefficients().data());
+  }
+}
+BENCHMARK(SplineCalculusInto)->Arg(0)->Arg(1);
+
+/**
+ * @brief Evaluate all 40 or 3 selected output dimensions of a spline of order
+ * 4 at 10000 points.
+ *
+ */
+static void SplineEvalSelect(benchmark::State &state) {
+  const Spline spline{randomSpline(4, 200, 40)};
+  const Eigen::ArrayXd points{0.5 * Eigen::ArrayXd::Random(10000) + 0.5};
+  const Eigen::ArrayXi dims{{4, 17, 31}};
+
+  for (auto _ : state)
+    if (state.range(0))
+      benchmark::DoNotOptimize(spline(points, dims));
+    else
+      benchmark::DoNotOptimize(spline(points));
+}
+BENCHMARK(SplineEvalSelect)->Arg(0)->Arg(1);
+
+}; // namespace Internal
+}; // namespace BasisSplines
@@ -0,0 +1,43 @@
+#include <Eigen/Core>
+#include <benchmark/benchmark.h>
+
+#include "basisSplines/spline.h"
+#include "basisSplines/splineLUT.h"
+#include "benchBase.h"
+
+namespace BasisSplines {
+namespace Internal {
+
+/**
+ * @brief Evaluate a spline of order 6 at unsorted points one by one.
+ *
+ */
+static void LUTSplineEval(benchmark::State &state) {
+  const Spline spline{randomSpline(6, 50)};
+  const Eigen::ArrayXd points{0.5 * Eigen::ArrayXd::Random(1000) + 0.5};
+
+  for (auto _ : state)
+    for (double point : points)
+      benchmark::DoNotOptimize(spline(Eigen::ArrayXd::Constant(1, point)));
+}
+BENCHMARK(LUTSplineEval);
+
+/**
+ * @brief Evaluate the lookup table of a spline of order 6 at unsorted points
+ * one by one.
+ *
+ */
+static void LUTLookup(benchmark::State &state) {
+  const Spline spline{randomSpline(6, 50)};
+  const SplineLUT lut{spline, 1e-6, static_cast<bool>(state.range(0))};
+  const Eigen::ArrayXd points{0.5 * Eigen::ArrayXd::Random(1000) + 0.5};
+
+  for (auto _ : state)
+    for (double point : points)
+      benchmark::DoNotOptimize(lut(point));
+  state.counters["intervals"] = lut.getNumIntervals();
+}
+BENCHMARK(LUTLookup)->Arg(0)->Arg(1);
+
+}; // namespace Internal
+}; // namespace BasisSplines
@@ -0,0 +1,49 @@
+#include <Eigen/Core>
+#include <benchmark/benchmark.h>
+
+#include "basisSplines/spline.h"
+#include "basisSplines/splineStats.h"
+#include "benchBase.h"
+
+namespace BasisSplines {
+namespace Internal {
+
+/**
+ * @brief Determine the mean and RMS of a spline of order 4 over 1000 windows
+ * by sampling each window at 100 points.
+ *
+ */
+static void StatsSampled(benchmark::State &state) {
+  const Spline spline{randomSpline(4, state.range(0), 2)};
+  const Eigen::ArrayXd begins{0.25 * Eigen::ArrayXd::Random(1000) + 0.25};
+
+  for (auto _ : state)
+    for (double begin : begins) {
+      const Eigen::ArrayXXd values{
+          spline(Eigen::ArrayXd::LinSpaced(100, begin, begin + 0.5))};
+      benchmark::DoNotOptimize(values.colwise().mean());
+      benchmark::DoNotOptimize(values.square().colwise().mean().sqrt());
+    }
+}
+BENCHMARK(StatsSampled)->Arg(50)->Arg(500);
+
+/**
+ * @brief Determine the mean and RMS of a spline of order 4 over 1000 windows
+ * in closed form.
+ *
+ */
+static void StatsClosedForm(benchmark::State &state) {
+  const Spline spline{randomSpline(4, state.range(0), 2)};
+  const SplineStats stats{spline};
+  const Eigen::ArrayXd begins{0.25 * Eigen::ArrayXd::Random(1000) + 0.25};
+  const Eigen::ArrayXd ends{begins + 0.5};
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(stats.mean(begins, ends));
+    benchmark::DoNotOptimize(stats.rms(begins, ends));
+  }
+}
+BENCHMARK(StatsClosedForm)->Arg(50)->Arg(500);
+
+}; // namespace Internal
+}; // namespace BasisSplines
@@ -0,0 +1,70 @@
+#include <Eigen/Core>
+#include <benchmark/benchmark.h>
+
+#include "basisSplines/spline.h"
+#include "basisSplines/splineWorkspace.h"
+#include "benchBase.h"
+
+namespace BasisSplines {
+namespace Internal {
+
+/**
+ * @brief Determine the derivative of the integral of a spline product with
+ * scratch buffers on the heap.
+ *
+ */
+static void SplineWorkspaceChainHeap(benchmark::State &state) {
+  const Spline splineL{randomSpline(4, 20)};
+  const Spline splineR{randomSpline(4, 15)};
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(splineL.prod(splineR).derivative().integral());
+}
+BENCHMARK(SplineWorkspaceChainHeap);
+
+/**
+ * @brief Determine the derivative of the integral of a spline product with
+ * scratch buffers from a workspace.
+ *
+ */
+static void SplineWorkspaceChainArena(benchmark::State &state) {
+  const Spline splineL{randomSpline(4, 20)};
+  const Spline splineR{randomSpline(4, 15)};
+
+  for (auto _ : state) {
+    SplineWorkspace workspace{};
+    benchmark::DoNotOptimize(splineL.prod(splineR).derivative().integral());
+  }
+}
+BENCHMARK(SplineWorkspaceChainArena);
+
+/**
+ * @brief Evaluate a spline basis with scratch buffers on the heap.
+ *
+ */
+static void SplineWorkspaceBasisEvalHeap(benchmark::State &state) {
+  const Spline spline{randomSpline(4, 20)};
+  const Eigen::ArrayXd points{0.5 * Eigen::ArrayXd::Random(1000) + 0.5};
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize((*spline.basis())(points));
+}
+BENCHMARK(SplineWorkspaceBasisEvalHeap);
+
+/**
+ * @brief Evaluate a spline basis with scratch buffers from a workspace.
+ *
+ */
+static void SplineWorkspaceBasisEvalArena(benchmark::State &state) {
+  const Spline spline{randomSpline(4, 20)};
+  const Eigen::ArrayXd points{0.5 * Eigen::ArrayXd::Random(1000) + 0.5};
+
+  for (auto _ : state) {
+    SplineWorkspace workspace{};
+    benchmark::DoNotOptimize((*spline.basis())(points));
+  }
+}
+BENCHMARK(SplineWorkspaceBasisEvalArena);
+
+}; // namespace Internal
+}; // namespace BasisSplines
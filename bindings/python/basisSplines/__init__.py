@@ -1,3 +1,3 @@
 from __future__ import annotations
-from basisSplines._core import Basis, Spline
-__all__: list[str] = ['Basis', 'Spline']
\ No newline at end of file
+from basisSplines._core import Async, Basis, BasisPool, CpuDispatch, HierarchicalBasis, MonotoneInverse, OperationCancelled, Project, QuantisedSpline, RationalSpline, RootsFuture, SmallBasis, SmallSpline, Spline, SplineFuture, SplineLUT, SplineStats, TransformCache, get_num_threads, set_grain_size, set_num_threads
+__all__: list[str] = ['Async', 'Basis', 'BasisPool', 'CpuDispatch', 'HierarchicalBasis', 'MonotoneInverse', 'OperationCancelled', 'Project', 'QuantisedSpline', 'RationalSpline', 'RootsFuture', 'SmallBasis', 'SmallSpline', 'Spline', 'SplineFuture', 'SplineLUT', 'SplineStats', 'TransformCache', 'get_num_threads', 'set_grain_size', 'set_num_threads']
\ No newline at end of file
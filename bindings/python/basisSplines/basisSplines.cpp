@@ -1,18 +1,113 @@
 
+#include "basisSplines/async.h"
 #include "basisSplines/basis.h"
+#include "basisSplines/basisPool.h"
+#include "basisSplines/cpuDispatch.h"
+#include "basisSplines/executor.h"
+#include "basisSplines/hierarchicalBasis.h"
 #include "basisSplines/interpolate.h"
+#include "basisSplines/monotoneInverse.h"
+#include "basisSplines/project.h"
+#include "basisSplines/quantisedSpline.h"
+#include "basisSplines/rationalSpline.h"
+#include "basisSplines/smallSpline.h"
 #include "basisSplines/spline.h"
+#include "basisSplines/splineLUT.h"
+#include "basisSplines/splineStats.h"
+#include "basisSplines/transformCache.h"
 
 #include <pybind11/eigen.h>
+#include <pybind11/functional.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
+#include <chrono>
+
 namespace py = pybind11;
 
 namespace BasisSplines {
 using namespace pybind11::literals;
 
+/**
+ * @brief Bind the Future of results of type "T" as "name". Waiting releases the
+ * GIL, such that operations calling Python processes can proceed.
+ *
+ * @tparam T type of the result.
+ * @param handle module to bind to.
+ * @param name Python class name.
+ */
+template <typename T> void bindFuture(py::module_ &handle, const char *name) {
+  py::classh<Future<T>>(handle, name, R"doc(
+Handle to the result of an asynchronous operation with cooperative cancellation.
+)doc")
+      .def("get", &Future<T>::get, py::call_guard<py::gil_scoped_release>(),
+           R"doc(Wait for and get the result. The future is empty afterwards.
+
+Returns:
+     Result of the operation.
+Raises:
+     OperationCancelled: The operation was cancelled.
+)doc")
+      .def("wait", &Future<T>::wait, py::call_guard<py::gil_scoped_release>(),
+           R"doc(Wait until the result is available.)doc")
+      .def(
+          "waitFor",
+          [](const Future<T> &future, double timeout) {
+            return future.waitFor(std::chrono::duration<double>{timeout});
+          },
+          "timeout"_a, py::call_guard<py::gil_scoped_release>(),
+          R"doc(Wait until the result is available or the timeout elapsed.
+
+Args:
+     timeout (float): Maximum duration to wait in seconds.
+Returns:
+     bool: Result is available.
+)doc")
+      .def("isReady", &Future<T>::isReady,
+           R"doc(Determine if the result is available without waiting.
+
+Returns:
+     bool: Result is available.
+)doc")
+      .def("valid", &Future<T>::valid,
+           R"doc(Determine if the future refers to a result.
+
+Returns:
+     bool: Future has a result that was not retrieved.
+)doc")
+      .def("cancel", &Future<T>::cancel,
+           R"doc(Request the cancellation of the operation.
+
+A pending operation is not started, a running operation stops at its next parallel loop.
+
+Returns:
+     bool: Stop was requested by this call.
+)doc");
+}
+
 PYBIND11_MODULE(_core, handle) {
+  handle.def("set_num_threads", &Executor::setNumThreads, "numThreads"_a,
+             R"doc(Set the number of threads of parallel evaluation, fitting and root finding.
+
+One thread runs all computations serially on the calling thread, zero selects the hardware concurrency.
+By default, computations run serially unless the environment variable BASIS_SPLINES_NUM_THREADS requests more threads.
+
+Args:
+     numThreads (int): Number of threads including the calling thread.
+)doc");
+  handle.def("get_num_threads", &Executor::getNumThreads,
+             R"doc(Get the number of threads of parallel evaluation, fitting and root finding.
+
+Returns:
+     int: Number of threads including the calling thread.
+)doc");
+  handle.def("set_grain_size", &Executor::setGrainSize, "grainSize"_a,
+             R"doc(Set the minimum number of work items, e.g. points, per parallel chunk.
+
+Args:
+     grainSize (int): Minimum number of work items per chunk.
+)doc");
+
   py::classh<Basis>(handle, "Basis", R"doc(
 Basis of piecewise polynomial functions represented by truncated powers.
 
@@ -165,6 +260,65 @@ Returns:
 
 Returns:
      np.ndarray: Basis knots.
+)doc")
+      .def("getSpan", &Basis::getSpan, "point"_a, "accSegment"_a = 1e-6,
+           R"doc(Determine the knot span [knots[span], knots[span + 1]] containing point.
+
+Args:
+     point (float): Query point.
+     accSegment (float, optional): Accuracy for assigning points outside the knots. Default is 1e-6.
+Returns:
+     int: Index of the first span knot or -1 if point is outside the knots.
+)doc")
+      .def(
+          "__eq__",
+          [](const Basis &self, const Basis &other) { return self == other; },
+          py::is_operator(), "other"_a,
+          R"doc(Test equality of order, scale and knots with other basis.
+
+Args:
+     other (Basis): Basis to compare.
+Returns:
+     bool: Bases are equal.
+)doc")
+      .def(
+          "__hash__", [](const Basis &self) { return self.hash(); },
+          R"doc(Get the hash of order, scale and knots.
+
+Returns:
+     int: Basis hash.
+)doc")
+      .def("hash", py::overload_cast<double>(&Basis::hash, py::const_),
+           "accKnots"_a,
+           R"doc(Determine the hash of order, scale and knots with knots rounded to multiples of accKnots.
+
+Args:
+     accKnots (float): Knot quantisation step.
+Returns:
+     int: Basis hash with quantised knots.
+)doc")
+      .def(
+          "evalSpan",
+          [](const Basis &self, double point, int span, double accBps) {
+            Eigen::VectorXd values(self.order());
+            self.evalSpan(point, span, values, accBps);
+            return values;
+          },
+          "point"_a, "span"_a, "accBps"_a = 1e-6,
+          R"doc(Evaluate the basis functions that are non-zero on the knot span at point.
+
+Args:
+     point (float): Evaluation point.
+     span (int): Knot span containing point, see getSpan.
+     accBps (float, optional): Minimum distance between breakpoints. Default is 1e-6.
+Returns:
+     np.ndarray: Values of the order basis functions starting at span - order + 1.
+)doc")
+      .def("setSpanIndex", &Basis::setSpanIndex, "bucketsPerKnot"_a = 2,
+           R"doc(Enable or disable the span index for getSpan.
+
+Args:
+     bucketsPerKnot (int, optional): Number of uniform buckets per knot, 0 disables the index. Default is 2.
 )doc")
       .def("setBreakpoints", &Basis::setBreakpoints, "breakpointsNew"_a,
            "idcs"_a,
@@ -193,6 +347,22 @@ Returns:
 
 Args:
      scale (float): Scaling factor.
+)doc")
+      .def(
+          "affine",
+          [](const Basis &self, double factor, double offset) {
+            return self.affine(factor, offset);
+          },
+          "factor"_a, "offset"_a,
+          R"doc(Create a new basis with knots mapped by t -> factor * t + offset.
+
+Args:
+     factor (float): Positive factor of the knots.
+     offset (float): Offset of the knots.
+Returns:
+     Basis: Basis with mapped knots.
+Raises:
+     ValueError: The factor is not positive.
 )doc")
       .def("__call__", &Basis::operator(), "points"_a, "accBps"_a = 1e-6,
            "accSegment"_a = 1e-6,
@@ -267,6 +437,145 @@ Returns:
      Tuple[np.ndarray, np.ndarray]: Breakpoints and their continuities.
 )doc");
 
+  py::classh<BasisPool>(handle, "BasisPool", R"doc(
+Global pool of canonical bases shared by splines with identical bases.
+
+If enabled, derived splines obtain their basis from the pool, such that equal bases are shared.
+Interned bases are shared and must not be modified.
+)doc")
+      .def_static("setEnabled", &BasisPool::setEnabled, "enabled"_a,
+                  R"doc(Enable or disable interning derived bases in the global pool.
+
+Args:
+     enabled (bool): Derived bases are interned.
+)doc")
+      .def_static("isEnabled", &BasisPool::isEnabled,
+                  R"doc(Determine if derived bases are interned in the global pool.
+
+Returns:
+     bool: Derived bases are interned.
+)doc")
+      .def_static(
+          "size", []() { return BasisPool::global().size(); },
+          R"doc(Get the number of bases in the global pool, which are used by any spline.
+
+Returns:
+     int: Number of pooled bases.
+)doc")
+      .def_static(
+          "clear", []() { BasisPool::global().clear(); },
+          R"doc(Remove all bases from the global pool.
+)doc");
+
+  py::classh<TransformCache>(handle, "TransformCache", R"doc(
+Global least recently used cache of bases and coefficient transformations of spline operations.
+
+If enabled by a positive capacity, Spline.add and Spline.prod reuse the transformations and Spline.derivative reuses the basis for equal bases.
+The memory of the cached transforms is limited to getMaxBytes.
+)doc")
+      .def_static(
+          "setCapacity",
+          [](size_t capacity) {
+            TransformCache::global().setCapacity(capacity);
+          },
+          "capacity"_a,
+          R"doc(Set the maximum number of cached transforms. Capacity zero disables the cache.
+
+Args:
+     capacity (int): Maximum number of cached transforms.
+)doc")
+      .def_static(
+          "getCapacity",
+          []() { return TransformCache::global().getCapacity(); },
+          R"doc(Get the maximum number of cached transforms.
+
+Returns:
+     int: Maximum number of cached transforms.
+)doc")
+      .def_static(
+          "setMaxBytes",
+          [](size_t maxBytes) { TransformCache::global().setMaxBytes(maxBytes); },
+          "maxBytes"_a,
+          R"doc(Set the maximum memory of the cached transforms. Transforms larger than the memory are not cached.
+
+Args:
+     maxBytes (int): Maximum memory of the cached transforms in bytes.
+)doc")
+      .def_static(
+          "getMaxBytes",
+          []() { return TransformCache::global().getMaxBytes(); },
+          R"doc(Get the maximum memory of the cached transforms.
+
+Returns:
+     int: Maximum memory of the cached transforms in bytes.
+)doc")
+      .def_static(
+          "getBytes", []() { return TransformCache::global().getBytes(); },
+          R"doc(Get the memory of the cached transforms.
+
+Returns:
+     int: Memory of the cached transforms in bytes.
+)doc")
+      .def_static(
+          "size", []() { return TransformCache::global().size(); },
+          R"doc(Get the number of cached transforms.
+
+Returns:
+     int: Number of cached transforms.
+)doc")
+      .def_static(
+          "getHits", []() { return TransformCache::global().getHits(); },
+          R"doc(Get the number of requests answered from the cache.
+
+Returns:
+     int: Number of cache hits.
+)doc")
+      .def_static(
+          "getMisses", []() { return TransformCache::global().getMisses(); },
+          R"doc(Get the number of requests requiring a computation.
+
+Returns:
+     int: Number of cache misses.
+)doc")
+      .def_static(
+          "clear", []() { TransformCache::global().clear(); },
+          R"doc(Remove all transforms and reset the statistics.
+)doc");
+
+  py::classh<CpuDispatch>(handle, "CpuDispatch", R"doc(
+Runtime selection of the instruction set level of the hot kernels.
+
+The kernels are compiled for the levels "baseline", "avx2" and "avx512" and selected by CPU detection at first use.
+The environment variable BASIS_SPLINES_ISA limits the level.
+)doc")
+      .def_static(
+          "getSupported",
+          []() { return CpuDispatch::getName(CpuDispatch::getSupported()); },
+          R"doc(Get the highest instruction set level supported by the CPU.
+
+Returns:
+     str: Supported instruction set level.
+)doc")
+      .def_static(
+          "getActive",
+          []() { return CpuDispatch::getName(CpuDispatch::getActive()); },
+          R"doc(Get the instruction set level used by the kernels.
+
+Returns:
+     str: Active instruction set level.
+)doc")
+      .def_static(
+          "setActive",
+          [](const std::string &isa) {
+            CpuDispatch::setActive(CpuDispatch::fromName(isa));
+          },
+          "isa"_a,
+          R"doc(Set the instruction set level used by the kernels, limited to the level supported by the CPU.
+
+Args:
+     isa (str): Requested instruction set level "baseline", "avx2" or "avx512".
+)doc");
+
   py::classh<Spline>(handle, "Spline", R"doc(
 Polynomial spline in basis form.
 
@@ -276,17 +585,21 @@ S(t) = C^T B(t)
 )doc")
       .def(py::init<>(), R"doc(Default constructor for an empty spline.)doc")
       .def(
-          py::init<const std::shared_ptr<Basis>, const Eigen::MatrixXd &>(),
-          "basis"_a, "coefficients"_a,
+          py::init<std::shared_ptr<Basis>, Eigen::MatrixXd>(), "basis"_a,
+          "coefficients"_a,
           R"doc(Construct a new spline in basis form from a basis and coefficients.
 
 Args:
      basis (Basis): Spline basis.
      coefficients (np.ndarray): Spline coefficients. Number of rows must correspond with basis dimensionality.
 )doc")
-      .def("getCoefficients", &Spline::getCoefficients,
-           py::return_value_policy::reference_internal,
-           R"doc(Get the spline coefficients.
+      .def(
+          "getCoefficients",
+          [](const Spline &self) -> const Eigen::MatrixXd & {
+            return self.getCoefficients();
+          },
+          py::return_value_policy::reference_internal,
+          R"doc(Get the spline coefficients.
 
 Returns:
      np.ndarray: Spline coefficients. Rows correspond with basis dimensionality, columns with output dimensionality.
@@ -309,7 +622,10 @@ Returns:
 Returns:
      int: Spline output dimensionality.
 )doc")
-      .def("__call__", &Spline::operator(), "points"_a,
+      .def("__call__",
+           py::overload_cast<const Eigen::ArrayXd &>(&Spline::operator(),
+                                                     py::const_),
+           "points"_a,
            R"doc(Evaluate spline at given points.
 
 Args:
@@ -317,13 +633,68 @@ Args:
 Returns:
      np.ndarray: Spline function values at points. Rows = number of points, columns = output dimensionality.
 )doc")
-      .def("derivative", &Spline::derivative, "orderDer"_a = 1,
+      .def("__call__",
+           py::overload_cast<const Eigen::ArrayXd &, const Eigen::ArrayXi &>(
+               &Spline::operator(), py::const_),
+           "points"_a, "dims"_a,
+           R"doc(Evaluate the output dimensions dims of the spline at given points.
+
+Args:
+     points (np.ndarray): Evaluation points.
+     dims (np.ndarray): Output dimensions to evaluate.
+Returns:
+     np.ndarray: Spline function values at points. Rows = number of points, columns = number of dims.
+)doc")
+      .def("select", &Spline::select, "dims"_a,
+           R"doc(Create new spline of the output dimensions dims sharing the basis.
+
+Args:
+     dims (np.ndarray): Output dimensions to select.
+Returns:
+     Spline: Spline with the output dimensions dims.
+)doc")
+      .def("evalSorted", &Spline::evalSorted, "points"_a,
+           R"doc(Evaluate spline at given unsorted points span by span.
+
+Args:
+     points (np.ndarray): Evaluation points.
+Returns:
+     np.ndarray: Spline function values at points. Rows = number of points, columns = output dimensionality.
+)doc")
+      .def_static("getSortedThreshold", &Spline::getSortedThreshold,
+                  R"doc(Get the number of points from which on spline evaluation is span-sorted.
+
+Returns:
+     int: Minimum number of points for span-sorted evaluation.
+)doc")
+      .def_static("setSortedThreshold", &Spline::setSortedThreshold,
+                  "threshold"_a,
+                  R"doc(Set the number of points from which on spline evaluation is span-sorted.
+
+Args:
+     threshold (int): Minimum number of points for span-sorted evaluation.
+)doc")
+      .def("derivative",
+           py::overload_cast<int>(&Spline::derivative, py::const_),
+           "orderDer"_a = 1,
            R"doc(Create new spline as derivative of this spline.
 
 Args:
      orderDer (int, optional): Derivative order. Default is 1.
 Returns:
      Spline: Derivative spline.
+)doc")
+      .def("derivative",
+           py::overload_cast<const Eigen::ArrayXi &, int>(&Spline::derivative,
+                                                          py::const_),
+           "dims"_a, "orderDer"_a = 1,
+           R"doc(Create new spline as derivative of the output dimensions dims of this spline.
+
+Args:
+     dims (np.ndarray): Output dimensions to differentiate.
+     orderDer (int, optional): Derivative order. Default is 1.
+Returns:
+     Spline: Derivative spline with the output dimensions dims.
 )doc")
       .def("integral", &Spline::integral, "orderInt"_a = 1,
            R"doc(Create new spline as integral of this spline.
@@ -332,6 +703,22 @@ Args:
      orderInt (int, optional): Integral order. Default is 1.
 Returns:
      Spline: Integral spline.
+)doc")
+      .def(
+          "affine",
+          [](const Spline &self, double factor, double offset) {
+            return self.affine(factor, offset);
+          },
+          "factor"_a, "offset"_a,
+          R"doc(Create new spline retimed by the map t -> factor * t + offset of its knots without refitting.
+
+Args:
+     factor (float): Positive factor of the knots.
+     offset (float): Offset of the knots.
+Returns:
+     Spline: Retimed spline, which at factor * t + offset equals this spline at t.
+Raises:
+     ValueError: The factor is not positive.
 )doc")
       .def("add", &Spline::add<Interpolate>, "other"_a, "accScale"_a = 1e-6,
            "accBps"_a = 1e-6,
@@ -354,6 +741,60 @@ Args:
      accBps (float, optional): Tolerance for assigning knots to breakpoint. Default is 1e-6.
 Returns:
      Spline: Spline product.
+)doc")
+      .def("derivativeInto", &Spline::derivativeInto, "out"_a,
+           "orderDer"_a = 1,
+           R"doc(Store the derivative of this spline in out, reusing its basis and coefficient storage if the structure matches.
+
+Args:
+     out (Spline): Derivative spline.
+     orderDer (int, optional): Derivative order. Default is 1.
+)doc")
+      .def("integralInto", &Spline::integralInto, "out"_a, "orderInt"_a = 1,
+           R"doc(Store the integral of this spline in out, reusing its basis and coefficient storage if the structure matches.
+
+Args:
+     out (Spline): Integral spline.
+     orderInt (int, optional): Integral order. Default is 1.
+)doc")
+      .def("addInto", &Spline::addInto<Interpolate>, "other"_a, "out"_a,
+           "accScale"_a = 1e-6, "accBps"_a = 1e-6,
+           R"doc(Store the sum of this and other spline in out, reusing the cached sum basis and the coefficient storage if the transform cache is enabled.
+
+Args:
+     other (Spline): Right spline summand.
+     out (Spline): Spline sum.
+     accScale (float, optional): Accepted difference between this and other splines' basis scaling. Default is 1e-6.
+     accBps (float, optional): Tolerance for assigning knots to breakpoint. Default is 1e-6.
+)doc")
+      .def("prodInto", &Spline::prodInto<Interpolate>, "other"_a, "out"_a,
+           "accScale"_a = 1e-6, "accBps"_a = 1e-6,
+           R"doc(Store the product of this and other spline in out, reusing the cached product basis and the coefficient storage if the transform cache is enabled.
+
+Args:
+     other (Spline): Right product spline.
+     out (Spline): Spline product.
+     accScale (float, optional): Accepted difference between this and other splines' basis scaling. Default is 1e-6.
+     accBps (float, optional): Tolerance for assigning knots to breakpoint. Default is 1e-6.
+)doc")
+      .def("insertKnotInto", &Spline::insertKnotInto, "knot"_a, "out"_a,
+           R"doc(Store the equivalent spline with inserted knot in out, reusing its basis and coefficient storage if the structure matches.
+
+Args:
+     knot (float): Knot to insert.
+     out (Spline): Spline including the given knot.
+)doc")
+      .def(
+          "compose", &Spline::compose<Interpolate>, "inner"_a,
+          "accBps"_a = 1e-6, "accRoot"_a = 1e-10,
+          R"doc(Create new spline as composition this(inner(t)) of this and the 1-dimensional inner spline.
+
+Args:
+     inner (Spline): 1-dimensional inner spline with range in the domain of this spline.
+     accBps (float, optional): Tolerance for assigning knots to breakpoint. Default is 1e-6.
+     accRoot (float, optional): Tolerance for the preimages of breakpoints. Default is 1e-10.
+Returns:
+     Spline: Spline composition.
 )doc")
       .def("insertKnots", &Spline::insertKnots, "knots"_a,
            R"doc(Create new spline including the given and this splines' knots.
@@ -397,6 +838,19 @@ Args:
      accAbs (float, optional): Tolerance for the spline output to be considered zero. Default is 1e-6.
 Returns:
      List[np.ndarray]: Roots along all output dimensions.
+)doc")
+      .def("getRoots",
+           py::overload_cast<const Eigen::ArrayXi &, int, double>(
+               &Spline::getRoots, py::const_),
+           "dims"_a, "maxIter"_a = 10, "accAbs"_a = 1e-6,
+           R"doc(Get the roots along the output dimensions dims.
+
+Args:
+     dims (np.ndarray): Output dimensions to find the roots of.
+     maxIter (int, optional): Maximum number of iterations. Default is 10.
+     accAbs (float, optional): Tolerance for the spline output to be considered zero. Default is 1e-6.
+Returns:
+     List[np.ndarray]: Roots along the output dimensions dims.
 )doc")
       .def("getRoots",
            py::overload_cast<int, int, double>(&Spline::getRoots, py::const_),
@@ -409,6 +863,37 @@ Args:
      accAbs (float, optional): Tolerance for the spline output to be considered zero. Default is 1e-6.
 Returns:
      np.ndarray: Roots along the given output dimension.
+)doc")
+      .def("getBezier", &Spline::getBezier, "span"_a,
+           R"doc(Determine the Bezier control points of the polynomial piece on the knot span [knots[span], knots[span + 1]].
+
+Args:
+     span (int): Index of the first knot of the span.
+Returns:
+     np.ndarray: Control points with order rows and dim columns.
+)doc")
+      .def(
+          "flatten", &Spline::flatten, "tolerance"_a, "sink"_a,
+          "maxDepth"_a = 32,
+          R"doc(Approximate the spline with a polyline whose distance to the spline does not exceed tolerance and pass its vertices to sink.
+
+Args:
+     tolerance (float): Maximum distance between spline and polyline.
+     sink (Callable[[float, np.ndarray], None]): Receives each vertex as point and spline value.
+     maxDepth (int, optional): Maximum recursion depth of the subdivision of each polynomial piece, which emits at most 2**maxDepth segments per piece. Default is 32.
+)doc")
+      .def(
+          "sampleUniform", &Spline::sampleUniform, "begin"_a, "step"_a,
+          "count"_a, "reanchor"_a = 64,
+          R"doc(Evaluate the spline at count uniformly spaced points begin + i * step by forward differencing.
+
+Args:
+     begin (float): First evaluation point.
+     step (float): Positive distance between evaluation points.
+     count (int): Number of evaluation points.
+     reanchor (int, optional): Number of samples between re-anchoring the difference table. Default is 64.
+Returns:
+     np.ndarray: Spline values with count rows and dim columns.
 )doc")
       .def("__neg__", &Spline::operator-,
            R"doc(Create new spline with negated spline coefficients.
@@ -416,5 +901,681 @@ Returns:
 Returns:
      Spline: Spline with negated coefficients.
 )doc");
+
+  py::classh<RationalSpline>(handle, "RationalSpline", R"doc(
+Rational spline in basis form (NURBS).
+
+Represents a multidimensional rational spline R(t) determined by its control points P, weights w, and a basis B(t).
+
+R(t) = (P^T W B(t)) / (w^T B(t))
+)doc")
+      .def(py::init<>(),
+           R"doc(Default constructor for an empty rational spline.)doc")
+      .def(
+          py::init<std::shared_ptr<Basis>, const Eigen::MatrixXd &,
+                   const Eigen::VectorXd &>(),
+          "basis"_a, "controlPoints"_a, "weights"_a,
+          R"doc(Construct a new rational spline from a basis, the control points and the weights.
+
+Args:
+     basis (Basis): Spline basis.
+     controlPoints (np.ndarray): Control points. Number of rows must correspond with basis dimensionality.
+     weights (np.ndarray): Positive control point weights.
+)doc")
+      .def(py::init<Spline>(), "homogeneous"_a,
+           R"doc(Construct a new rational spline from its homogeneous representation.
+
+Args:
+     homogeneous (Spline): Spline in homogeneous coordinates with the weights in the last output dimension.
+)doc")
+      .def("homogeneous", &RationalSpline::homogeneous,
+           py::return_value_policy::reference_internal,
+           R"doc(Get the spline in homogeneous coordinates.
+
+Returns:
+     Spline: Homogeneous spline.
+)doc")
+      .def("basis", &RationalSpline::basis,
+           R"doc(Get the spline basis.
+
+Returns:
+     Basis: Spline basis.
+)doc")
+      .def("getControlPoints", &RationalSpline::getControlPoints,
+           R"doc(Get the control points.
+
+Returns:
+     np.ndarray: Control points.
+)doc")
+      .def("getWeights", &RationalSpline::getWeights,
+           R"doc(Get the control point weights.
+
+Returns:
+     np.ndarray: Weights.
+)doc")
+      .def("dim", &RationalSpline::dim,
+           R"doc(Get the spline output dimensionality.
+
+Returns:
+     int: Spline output dimensionality.
+)doc")
+      .def("__call__", &RationalSpline::operator(), "points"_a,
+           R"doc(Evaluate rational spline at given points.
+
+Args:
+     points (np.ndarray): Evaluation points.
+Returns:
+     np.ndarray: Spline values. Rows = number of points, columns = output dimensionality.
+)doc")
+      .def("derivative", &RationalSpline::derivative, "points"_a,
+           "orderDer"_a = 1,
+           R"doc(Evaluate the derivative of given order at the given points.
+
+Args:
+     points (np.ndarray): Evaluation points.
+     orderDer (int, optional): Derivative order. Default is 1.
+Returns:
+     np.ndarray: Derivative values. Rows = number of points, columns = output dimensionality.
+)doc")
+      .def("insertKnots", &RationalSpline::insertKnots, "knots"_a,
+           R"doc(Create equivalent rational spline with inserted knots.
+
+Args:
+     knots (np.ndarray): Knots to insert.
+Returns:
+     RationalSpline: New rational spline including the given knots.
+)doc")
+      .def("insertKnot", &RationalSpline::insertKnot, "knot"_a,
+           R"doc(Create equivalent rational spline with inserted knot.
+
+Args:
+     knot (float): Knot to insert.
+Returns:
+     RationalSpline: New rational spline including the given knot.
+)doc");
+
+  py::classh<MonotoneInverse>(handle, "MonotoneInverse", R"doc(
+Inverse of a monotone spline along one output dimension.
+
+Each query value is assigned to a polynomial piece by a binary search on the values at the piece ends.
+The point within the piece is determined by Newton iterations safeguarded by the Illinois variant of the regula falsi.
+)doc")
+      .def(py::init<const Spline &, int, double>(), "spline"_a, "dim"_a = 0,
+           "accMono"_a = 0.0,
+           R"doc(Construct the inverse of the given spline along the output dimension dim.
+
+Args:
+     spline (Spline): Spline with monotone coefficients.
+     dim (int, optional): Output dimension to invert. Default is 0.
+     accMono (float, optional): Tolerated violation of coefficient monotonicity. Default is 0.0.
+Raises:
+     ValueError: The spline coefficients are not monotone.
+)doc")
+      .def("__call__",
+           py::overload_cast<double, int, double>(&MonotoneInverse::operator(),
+                                                  py::const_),
+           "value"_a, "maxIter"_a = 32, "accAbs"_a = 1e-12,
+           R"doc(Determine the point at which the spline takes the given value.
+
+Args:
+     value (float): Spline value to invert. Values outside the spline range are mapped to the domain ends.
+     maxIter (int, optional): Maximum number of iterations. Default is 32.
+     accAbs (float, optional): Tolerance for the spline value. Default is 1e-12.
+Returns:
+     float: Point with the given spline value.
+)doc")
+      .def("__call__",
+           py::overload_cast<const Eigen::ArrayXd &, bool, int, double>(
+               &MonotoneInverse::operator(), py::const_),
+           "values"_a, "sorted"_a = false, "maxIter"_a = 32,
+           "accAbs"_a = 1e-12,
+           R"doc(Determine the points at which the spline takes the given values.
+
+Args:
+     values (np.ndarray): Spline values to invert.
+     sorted (bool, optional): Values are sorted along the spline monotonicity. Default is False.
+     maxIter (int, optional): Maximum number of iterations. Default is 32.
+     accAbs (float, optional): Tolerance for the spline value. Default is 1e-12.
+Returns:
+     np.ndarray: Points with the given spline values.
+)doc")
+      .def("begin", &MonotoneInverse::begin,
+           R"doc(Get the first point of the inverse range.
+
+Returns:
+     float: First point of the spline domain.
+)doc")
+      .def("end", &MonotoneInverse::end,
+           R"doc(Get the last point of the inverse range.
+
+Returns:
+     float: Last point of the spline domain.
+)doc");
+
+  py::classh<SplineLUT>(handle, "SplineLUT", R"doc(
+Lookup table approximating a spline on a uniform grid.
+
+The spline is interpolated on each grid interval by a linear or a cubic Hermite polynomial.
+The grid step is chosen from derivative bounds such that the interpolation error is below a given tolerance.
+)doc")
+      .def(py::init<const Spline &, double, bool, int>(), "spline"_a,
+           "tolerance"_a, "cubic"_a = false, "maxIntervals"_a = 1 << 22,
+           R"doc(Construct the lookup table of the spline with interpolation error less than tolerance.
+
+Args:
+     spline (Spline): Spline to approximate.
+     tolerance (float): Maximum interpolation error.
+     cubic (bool, optional): Use cubic Hermite instead of linear interpolation. Default is False.
+     maxIntervals (int, optional): Maximum number of grid intervals. Default is 4194304.
+Raises:
+     ValueError: The spline is discontinuous or requires more than maxIntervals intervals.
+)doc")
+      .def("__call__",
+           py::overload_cast<double, int>(&SplineLUT::operator(), py::const_),
+           "point"_a, "dim"_a = 0,
+           R"doc(Evaluate the lookup table at point for the output dimension dim.
+
+Args:
+     point (float): Evaluation point. Points outside the spline domain are clamped to the domain.
+     dim (int, optional): Output dimension. Default is 0.
+Returns:
+     float: Approximate spline value.
+)doc")
+      .def("__call__",
+           py::overload_cast<const Eigen::ArrayXd &>(&SplineLUT::operator(),
+                                                     py::const_),
+           "points"_a,
+           R"doc(Evaluate the lookup table at the given points.
+
+Args:
+     points (np.ndarray): Evaluation points.
+Returns:
+     np.ndarray: Approximate spline values. Rows = number of points, columns = output dimensionality.
+)doc")
+      .def("getErrorBound", &SplineLUT::getErrorBound,
+           R"doc(Get the bound of the interpolation error.
+
+Returns:
+     float: Maximum interpolation error.
+)doc")
+      .def("getNumIntervals", &SplineLUT::getNumIntervals,
+           R"doc(Get the number of grid intervals.
+
+Returns:
+     int: Number of grid intervals.
+)doc")
+      .def("begin", &SplineLUT::begin,
+           R"doc(Get the first point of the spline domain.
+
+Returns:
+     float: First point of the lookup table.
+)doc")
+      .def("end", &SplineLUT::end,
+           R"doc(Get the last point of the spline domain.
+
+Returns:
+     float: Last point of the lookup table.
+)doc")
+      .def("dim", &SplineLUT::dim,
+           R"doc(Get the output dimensionality.
+
+Returns:
+     int: Output dimensionality.
+)doc");
+
+  py::classh<SplineStats>(handle, "SplineStats", R"doc(
+Closed-form statistics of a spline over windows of its domain.
+
+The antiderivatives of the spline and its square are determined once, such that each window is answered in O(log n).
+Windows are given by their first and last points within the spline domain.
+The statistics have one row per window and one column per output dimension.
+Window limits are in knot units, integrals and durations are scaled by the basis scale like Spline.integral.
+)doc")
+      .def(py::init<const Spline &, double, double>(), "spline"_a,
+           "accScale"_a = 1e-6, "accBps"_a = 1e-6,
+           R"doc(Construct the statistics of the spline.
+
+Args:
+     spline (Spline): Spline to determine the statistics of.
+     accScale (float, optional): Accepted difference between the basis scalings of the squared spline. Default is 1e-6.
+     accBps (float, optional): Tolerance for assigning knots to breakpoints. Default is 1e-6.
+)doc")
+      .def("integral", &SplineStats::integral, "begins"_a, "ends"_a,
+           R"doc(Determine the integral of the spline over each window.
+
+Args:
+     begins (np.ndarray): First points of the windows.
+     ends (np.ndarray): Last points of the windows.
+Returns:
+     np.ndarray: Integrals over the windows.
+Raises:
+     ValueError: The windows are empty or exceed the spline domain.
+)doc")
+      .def("mean", &SplineStats::mean, "begins"_a, "ends"_a,
+           R"doc(Determine the mean of the spline over each window.
+
+Args:
+     begins (np.ndarray): First points of the windows.
+     ends (np.ndarray): Last points of the windows.
+Returns:
+     np.ndarray: Means over the windows.
+Raises:
+     ValueError: The windows are empty or exceed the spline domain.
+)doc")
+      .def("meanSquare", &SplineStats::meanSquare, "begins"_a, "ends"_a,
+           R"doc(Determine the mean of the squared spline over each window.
+
+Args:
+     begins (np.ndarray): First points of the windows.
+     ends (np.ndarray): Last points of the windows.
+Returns:
+     np.ndarray: Means of the squared spline over the windows.
+Raises:
+     ValueError: The windows are empty or exceed the spline domain.
+)doc")
+      .def("variance", &SplineStats::variance, "begins"_a, "ends"_a,
+           R"doc(Determine the variance of the spline over each window.
+
+Args:
+     begins (np.ndarray): First points of the windows.
+     ends (np.ndarray): Last points of the windows.
+Returns:
+     np.ndarray: Variances over the windows.
+Raises:
+     ValueError: The windows are empty or exceed the spline domain.
+)doc")
+      .def("rms", &SplineStats::rms, "begins"_a, "ends"_a,
+           R"doc(Determine the root mean square of the spline over each window.
+
+Args:
+     begins (np.ndarray): First points of the windows.
+     ends (np.ndarray): Last points of the windows.
+Returns:
+     np.ndarray: Root mean squares over the windows.
+Raises:
+     ValueError: The windows are empty or exceed the spline domain.
+)doc")
+      .def("timeAbove", &SplineStats::timeAbove, "threshold"_a, "begins"_a,
+           "ends"_a, "maxIter"_a = 10, "accAbs"_a = 1e-6,
+           R"doc(Determine the time the spline exceeds the threshold in each window.
+
+Args:
+     threshold (float): Value to exceed.
+     begins (np.ndarray): First points of the windows.
+     ends (np.ndarray): Last points of the windows.
+     maxIter (int, optional): Maximum number of iterations of the root estimation. Default is 10.
+     accAbs (float, optional): Tolerance for the shifted spline to be considered zero. Default is 1e-6.
+Returns:
+     np.ndarray: Durations above the threshold in the windows.
+Raises:
+     ValueError: The windows are empty or exceed the spline domain.
+)doc")
+      .def("begin", &SplineStats::begin,
+           R"doc(Get the first point of the spline domain.
+
+Returns:
+     float: First point of the domain.
+)doc")
+      .def("end", &SplineStats::end,
+           R"doc(Get the last point of the spline domain.
+
+Returns:
+     float: Last point of the domain.
+)doc")
+      .def("dim", &SplineStats::dim,
+           R"doc(Get the output dimensionality.
+
+Returns:
+     int: Output dimensionality.
+)doc");
+
+  py::classh<Project>(handle, "Project", R"doc(
+Determines the spline coefficients for a basis as L2 projection of a process.
+
+The coefficients minimise the integral of the squared difference between the spline and the process over the knot range.
+The integrals are computed by Gauss-Legendre quadrature on each knot span and the banded mass matrix is factorised once on construction.
+Unlike interpolation at the Greville sites, the projection does not alias oscillations between the sites.
+)doc")
+      .def(py::init<std::shared_ptr<Basis>, int>(), "basis"_a,
+           "numNodes"_a = 0,
+           R"doc(Construct a new projection for the given basis.
+
+Args:
+     basis (Basis): Spline basis.
+     numNodes (int, optional): Number of quadrature nodes per knot span, 0 selects the basis order. Default is 0.
+)doc")
+      .def("fit", &Project::fit, "process"_a,
+           R"doc(Determine the spline coefficients as L2 projection of the process.
+
+Args:
+     process (Callable[[np.ndarray], np.ndarray]): Function representation of the process, called once with all quadrature points.
+Returns:
+     np.ndarray: Spline coefficients. Rows correspond with basis dimensionality, columns with output dimensionality.
+)doc")
+      .def("getPoints", &Project::getPoints,
+           R"doc(Get the quadrature points at which the process is evaluated.
+
+Returns:
+     np.ndarray: Quadrature points.
+)doc");
+
+  py::classh<HierarchicalBasis>(handle, "HierarchicalBasis", R"doc(
+Truncated hierarchical B-spline basis for local refinement.
+
+Each level results from inserting the midpoint of each knot span of the previous level.
+Refining cells of a level activates finer functions on the refined cells only.
+The active functions are truncated, such that they are linearly independent and form a partition of unity.
+)doc")
+      .def(py::init<std::shared_ptr<Basis>>(), "basis"_a,
+           R"doc(Construct a hierarchical basis with the level 0 basis.
+
+Args:
+     basis (Basis): Clamped basis of level 0.
+Raises:
+     ValueError: The basis is not clamped.
+)doc")
+      .def("refine", &HierarchicalBasis::refine, "level"_a, "begin"_a,
+           "end"_a,
+           R"doc(Refine the cells of the level that intersect the interval.
+
+Args:
+     level (int): Level of the cells to refine.
+     begin (float): First point of the refined interval.
+     end (float): Last point of the refined interval.
+Raises:
+     ValueError: The level does not exist or the interval is empty.
+)doc")
+      .def("__call__", &HierarchicalBasis::operator(), "points"_a,
+           R"doc(Evaluate the active functions at the given points.
+
+Args:
+     points (np.ndarray): Evaluation points.
+Returns:
+     np.ndarray: Function values with one column per active function.
+)doc")
+      .def("fit", &HierarchicalBasis::fit<>, "observations"_a, "points"_a,
+           R"doc(Determine the least-squares coefficients of the active functions.
+
+Args:
+     observations (np.ndarray): Values to fit the spline function.
+     points (np.ndarray): Evaluation points corresponding to the observations.
+Returns:
+     np.ndarray: Coefficients of the active functions.
+)doc")
+      .def("toSpline", &HierarchicalBasis::toSpline, "coefficients"_a,
+           R"doc(Create the spline in the finest basis equal to the hierarchical spline.
+
+Args:
+     coefficients (np.ndarray): Coefficients of the active functions.
+Returns:
+     Spline: Spline equal to the hierarchical spline.
+)doc")
+      .def("dim", &HierarchicalBasis::dim,
+           R"doc(Determine the number of active functions.
+
+Returns:
+     int: Basis dimensionality.
+)doc")
+      .def("order", &HierarchicalBasis::order,
+           R"doc(Determine the basis order.
+
+Returns:
+     int: Basis order.
+)doc")
+      .def("numLevels", &HierarchicalBasis::numLevels,
+           R"doc(Determine the number of levels.
+
+Returns:
+     int: Number of levels.
+)doc")
+      .def("getBasis", &HierarchicalBasis::getBasis, "level"_a,
+           R"doc(Get the basis of the given level.
+
+Args:
+     level (int): Basis level.
+Returns:
+     Basis: Basis of the level.
+)doc")
+      .def("getActive", &HierarchicalBasis::getActive, "level"_a,
+           R"doc(Get the indices of the active functions of the level in its basis.
+
+Args:
+     level (int): Basis level.
+Returns:
+     np.ndarray: Indices of the active functions.
+)doc")
+      .def("getTransform", &HierarchicalBasis::getTransform,
+           R"doc(Get the coefficients of the active functions in the finest basis.
+
+Returns:
+     scipy.sparse.csr_matrix: Sparse coefficients with one column per active function.
+)doc");
+
+  py::classh<QuantisedSpline>(handle, "QuantisedSpline", R"doc(
+Polynomial spline with quantised coefficients and knots.
+
+The coefficients of each output dimension are stored as 16 bit integers with a scale and an offset.
+The knots are stored as the first knot and the offsets to the first knot in 32 bit fixed point.
+)doc")
+      .def(py::init<const Spline &, int>(), "spline"_a, "numSamples"_a = 8,
+           R"doc(Construct a quantised representation of the spline.
+
+Args:
+     spline (Spline): Spline to quantise.
+     numSamples (int, optional): Number of points per span to determine the error. Default is 8.
+)doc")
+      .def("__call__", &QuantisedSpline::operator(), "points"_a,
+           "accSegment"_a = 1e-6,
+           R"doc(Evaluate the quantised spline at the given points.
+
+Args:
+     points (np.ndarray): Evaluation points.
+     accSegment (float, optional): Accuracy for assigning points outside the domain. Default is 1e-6.
+Returns:
+     np.ndarray: Spline values. Rows = number of points, columns = output dimensionality.
+)doc")
+      .def("toSpline", &QuantisedSpline::toSpline,
+           R"doc(Decode the quantised spline to a spline.
+
+Returns:
+     Spline: Spline with dequantised coefficients and knots.
+)doc")
+      .def("getMaxError", &QuantisedSpline::getMaxError,
+           R"doc(Get the maximum error of the quantised spline on the spline domain.
+
+Returns:
+     float: Maximum absolute error.
+)doc")
+      .def("getBytes", &QuantisedSpline::getBytes,
+           R"doc(Get the number of bytes occupied by the quantised data.
+
+Returns:
+     int: Number of bytes.
+)doc")
+      .def("dim", &QuantisedSpline::dim,
+           R"doc(Get the spline output dimensionality.
+
+Returns:
+     int: Spline output dimensionality.
+)doc");
+
+  py::classh<SmallBasis>(handle, "SmallBasis", R"doc(
+Basis with inline knot storage for at most SmallBasis.maxKnots knots.
+
+Creating and copying small bases requires no heap allocation.
+)doc")
+      .def_readonly_static("maxKnots", &SmallBasis::maxKnots,
+                           R"doc(Knot capacity.)doc")
+      .def(py::init<const Basis &>(), "basis"_a,
+           R"doc(Construct a new small basis from a basis.
+
+Args:
+     basis (Basis): Basis to copy. Must not exceed SmallBasis.maxKnots knots.
+)doc")
+      .def("toBasis", &SmallBasis::toBasis,
+           R"doc(Convert to a basis with heap knot storage.
+
+Returns:
+     Basis: Basis with equal knots, order and scale.
+)doc")
+      .def(
+          "knots",
+          [](const SmallBasis &self) { return Eigen::ArrayXd{self.knots()}; },
+          R"doc(Get the basis knots.
+
+Returns:
+     np.ndarray: Basis knots.
+)doc")
+      .def("order", &SmallBasis::order,
+           R"doc(Get the basis order.
+
+Returns:
+     int: Basis order.
+)doc")
+      .def("dim", &SmallBasis::dim,
+           R"doc(Get the basis dimensionality.
+
+Returns:
+     int: Number of basis functions.
+)doc");
+
+  py::classh<SmallSpline>(handle, "SmallSpline", R"doc(
+Spline with inline storage of at most SmallBasis.maxKnots knots and SmallSpline.maxDim output dimensions.
+
+Creating, copying, evaluating and differentiating small splines requires no heap allocation.
+)doc")
+      .def_readonly_static("maxDim", &SmallSpline::maxDim,
+                           R"doc(Output dimensionality capacity.)doc")
+      .def(py::init<const Spline &>(), "spline"_a,
+           R"doc(Construct a new small spline from a spline.
+
+Args:
+     spline (Spline): Spline to copy. Must not exceed the inline capacity.
+)doc")
+      .def("toSpline", &SmallSpline::toSpline,
+           R"doc(Convert to a spline with heap storage.
+
+Returns:
+     Spline: Spline with equal basis and coefficients.
+)doc")
+      .def("basis", &SmallSpline::basis,
+           py::return_value_policy::reference_internal,
+           R"doc(Get the spline basis.
+
+Returns:
+     SmallBasis: Spline basis.
+)doc")
+      .def(
+          "getCoefficients",
+          [](const SmallSpline &self) {
+            return Eigen::MatrixXd{self.getCoefficients()};
+          },
+          R"doc(Get the spline coefficients.
+
+Returns:
+     np.ndarray: Spline coefficients. Rows correspond with basis dimensionality, columns with output dimensionality.
+)doc")
+      .def("__call__",
+           py::overload_cast<const Eigen::ArrayXd &>(&SmallSpline::operator(),
+                                                     py::const_),
+           "points"_a,
+           R"doc(Evaluate the spline at the given points.
+
+Args:
+     points (np.ndarray): Evaluation points.
+Returns:
+     np.ndarray: Spline values. Rows = number of points, columns = output dimensionality.
+)doc")
+      .def("derivative", &SmallSpline::derivative, "orderDer"_a = 1,
+           R"doc(Create new small spline as derivative of this spline.
+
+Args:
+     orderDer (int, optional): Derivative order. Default is 1.
+Returns:
+     SmallSpline: Derivative spline.
+)doc")
+      .def("dim", &SmallSpline::dim,
+           R"doc(Get the spline output dimensionality.
+
+Returns:
+     int: Spline output dimensionality.
+)doc");
+
+  py::register_exception<OperationCancelled>(handle, "OperationCancelled");
+  bindFuture<Spline>(handle, "SplineFuture");
+  bindFuture<std::vector<Eigen::ArrayXd>>(handle, "RootsFuture");
+
+  py::classh<Async>(handle, "Async", R"doc(
+Asynchronous variants of expensive spline operations.
+
+The operations run on a background thread and return a future immediately.
+The arguments are copied including their bases, such that they may be modified while the operation is pending.
+The cancellation is coarse, it is observed before the operation starts and at the start of parallel loops.
+)doc")
+      .def_static(
+          "fit",
+          py::overload_cast<const std::shared_ptr<Basis> &, Eigen::MatrixXd,
+                            Eigen::VectorXd>(&Async::fit<Interpolate>),
+          "basis"_a, "observations"_a, "points"_a,
+          R"doc(Fit a spline with the given basis at the points to the observations asynchronously.
+
+Args:
+     basis (Basis): Spline basis.
+     observations (np.ndarray): Values to fit the spline function.
+     points (np.ndarray): Evaluation points corresponding to the observations.
+Returns:
+     SplineFuture: Spline fitting the observations.
+)doc")
+      .def_static(
+          "fit",
+          py::overload_cast<const std::shared_ptr<Basis> &,
+                            std::function<Eigen::MatrixXd(Eigen::VectorXd)>>(
+              &Async::fit<Interpolate>),
+          "basis"_a, "process"_a,
+          R"doc(Fit a spline with the given basis to the process asynchronously.
+
+The process is called on a background thread, which acquires the GIL.
+
+Args:
+     basis (Basis): Spline basis.
+     process (Callable[[np.ndarray], np.ndarray]): Function representation of the process.
+Returns:
+     SplineFuture: Spline fitting the process.
+)doc")
+      .def_static("add", &Async::add<Interpolate>, "left"_a, "right"_a,
+                  "accScale"_a = 1e-6, "accBps"_a = 1e-6,
+                  R"doc(Create the sum of the left and right spline asynchronously.
+
+Args:
+     left (Spline): Left spline summand.
+     right (Spline): Right spline summand.
+     accScale (float, optional): Accepted difference between the splines' basis scaling. Default is 1e-6.
+     accBps (float, optional): Tolerance for assigning knots to breakpoints. Default is 1e-6.
+Returns:
+     SplineFuture: Representation of the spline sum.
+)doc")
+      .def_static("prod", &Async::prod<Interpolate>, "left"_a, "right"_a,
+                  "accScale"_a = 1e-6, "accBps"_a = 1e-6,
+                  R"doc(Create the product of the left and right spline asynchronously.
+
+Args:
+     left (Spline): Left product spline.
+     right (Spline): Right product spline.
+     accScale (float, optional): Accepted difference between the splines' basis scaling. Default is 1e-6.
+     accBps (float, optional): Tolerance for assigning knots to breakpoints. Default is 1e-6.
+Returns:
+     SplineFuture: Representation of the spline product.
+)doc")
+      .def_static("getRoots", &Async::getRoots, "spline"_a, "maxIter"_a = 10,
+                  "accAbs"_a = 1e-6,
+                  R"doc(Get the roots of the spline along all output dimensions asynchronously.
+
+Args:
+     spline (Spline): Spline to find the roots of.
+     maxIter (int, optional): Maximum number of iterations. Default is 10.
+     accAbs (float, optional): Tolerance for the spline output to be considered zero. Default is 1e-6.
+Returns:
+     RootsFuture: Roots along all output dimensions.
+)doc");
 }
 } // namespace BasisSplines
\ No newline at end of file
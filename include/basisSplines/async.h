@@ -0,0 +1,297 @@
+#ifndef ASYNC_H
+#define ASYNC_H
+
+#include <Eigen/Core>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <stop_token>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "basisSplines/basis.h"
+#include "basisSplines/executor.h"
+#include "basisSplines/interpolate.h"
+#include "basisSplines/spline.h"
+
+namespace BasisSplines {
+
+/**
+ * @brief Handle to the result of an asynchronous operation with cooperative
+ * cancellation.
+ *
+ * @tparam T type of the result.
+ */
+template <typename T> class Future {
+public:
+  // MARK: public methods
+
+  /**
+   * @brief Construct an empty Future without shared state.
+   *
+   */
+  Future() = default;
+
+  /**
+   * @brief Construct a new Future from the "future" of the result and the
+   * "stopSource" cancelling the operation.
+   *
+   * @param future future of the result.
+   * @param stopSource source to request the cancellation of the operation.
+   */
+  Future(std::future<T> future, std::stop_source stopSource)
+      : m_future{std::move(future)}, m_stopSource{std::move(stopSource)} {}
+
+  /**
+   * @brief Wait for and get the result. Rethrows the exception of the
+   * operation, i.e. OperationCancelled if the operation was cancelled. The
+   * Future is empty afterwards.
+   *
+   * @return T result of the operation.
+   */
+  T get() { return m_future.get(); }
+
+  /**
+   * @brief Wait until the result is available.
+   *
+   */
+  void wait() const { m_future.wait(); }
+
+  /**
+   * @brief Wait until the result is available or the "timeout" elapsed.
+   *
+   * @param timeout maximum duration to wait.
+   * @return true result is available.
+   * @return false timeout elapsed.
+   */
+  template <typename Rep, typename Period>
+  bool waitFor(const std::chrono::duration<Rep, Period> &timeout) const {
+    return m_future.wait_for(timeout) == std::future_status::ready;
+  }
+
+  /**
+   * @brief Determine if the result is available without waiting.
+   *
+   * @return true result is available.
+   * @return false operation is pending.
+   */
+  bool isReady() const { return waitFor(std::chrono::seconds{0}); }
+
+  /**
+   * @brief Determine if the Future refers to a result.
+   *
+   * @return true Future has shared state.
+   * @return false Future is empty or its result was retrieved.
+   */
+  bool valid() const { return m_future.valid(); }
+
+  /**
+   * @brief Request the cancellation of the operation. A pending operation is
+   * not started, a running operation stops at its next parallel loop. An
+   * operation that already finished keeps its result.
+   *
+   * @return true stop was requested by this call.
+   * @return false stop was already requested.
+   */
+  bool cancel() { return m_stopSource.request_stop(); }
+
+  /**
+   * @brief Get the token observed by the operation.
+   *
+   * @return std::stop_token token to observe the cancellation.
+   */
+  std::stop_token getStopToken() const { return m_stopSource.get_token(); }
+
+private:
+  // MARK: private properties
+
+  std::future<T> m_future{};       /**<< result of the operation */
+  std::stop_source m_stopSource{}; /**<< cancels the operation */
+};
+
+/**
+ * @brief Asynchronous variants of expensive spline operations.
+ *
+ * The operations are submitted to the background queue of the Executor and
+ * return a Future immediately. Arguments are copied into the operation
+ * including the bases of the splines, such that the caller may modify or
+ * destroy them while the operation is pending. The results have their own
+ * bases, which are equal to but not shared with the arguments' bases. If the
+ * BasisPool is enabled, derived result bases are interned and thus shared with
+ * other splines of equal bases, including arguments obtained from the pool.
+ *
+ * Operations launched within an asynchronous operation are executed on its
+ * thread before Async::launch returns. Hence, an operation may wait for the
+ * Future of a nested operation without blocking a background worker.
+ *
+ * Cancelled operations throw OperationCancelled from Future::get. The
+ * cancellation is coarse. It is observed before the operation starts and at
+ * the start of parallel loops and their chunks, see Executor::parallelFor.
+ * Sequential parts, e.g. the decomposition of Interpolate::fit, run to
+ * completion.
+ */
+class Async {
+public:
+  // MARK: public methods
+
+  /**
+   * @brief Execute "func" asynchronously. Within "func",
+   * Executor::isCancelled and Executor::throwIfCancelled observe the
+   * cancellation, and parallel loops throw OperationCancelled after it.
+   *
+   * @tparam Func type of the function without arguments.
+   * @param func function to execute.
+   * @return Future<std::invoke_result_t<Func &>> result of "func".
+   */
+  template <typename Func>
+  static Future<std::invoke_result_t<Func &>> launch(Func func) {
+    using Result = std::invoke_result_t<Func &>;
+
+    const std::shared_ptr<std::promise<Result>> promise{
+        std::make_shared<std::promise<Result>>()};
+    std::stop_source stopSource{};
+    Future<Result> future{promise->get_future(), stopSource};
+
+    Executor::submit([promise, func = std::move(func),
+                      token = stopSource.get_token()]() mutable {
+      try {
+        Executor::withStopToken(token, [&]() {
+          Executor::throwIfCancelled();
+          if constexpr (std::is_void_v<Result>) {
+            func();
+            promise->set_value();
+          } else
+            promise->set_value(func());
+        });
+      } catch (...) {
+        promise->set_exception(std::current_exception());
+      }
+    });
+
+    return future;
+  }
+
+  /**
+   * @brief Fit a spline with the given "basis" at the "points" to the
+   * "observations" asynchronously.
+   *
+   * @tparam Interp type of interpolation.
+   * @param basis spline basis.
+   * @param observations values to fit the spline function.
+   * @param points evaluation points corresponding to the "observations".
+   * @return Future<Spline> spline fitting the observations.
+   */
+  template <typename Interp = Interpolate>
+  static Future<Spline> fit(const std::shared_ptr<Basis> &basis,
+                            Eigen::MatrixXd observations,
+                            Eigen::VectorXd points) {
+    return launch([basis{copyBasis(basis)},
+                   observations{std::move(observations)},
+                   points{std::move(points)}]() {
+      return Spline{basis, Interp{basis}.fit(observations, points)};
+    });
+  }
+
+  /**
+   * @brief Fit a spline with the given "basis" to the "process"
+   * asynchronously. The process is called on a background thread.
+   *
+   * @tparam Interp type of interpolation.
+   * @param basis spline basis.
+   * @param process function representation of the process.
+   * @return Future<Spline> spline fitting the process.
+   */
+  template <typename Interp = Interpolate>
+  static Future<Spline>
+  fit(const std::shared_ptr<Basis> &basis,
+      std::function<Eigen::MatrixXd(Eigen::VectorXd)> process) {
+    return launch([basis{copyBasis(basis)}, process{std::move(process)}]() {
+      return Spline{basis, Interp{basis}.fit(process)};
+    });
+  }
+
+  /**
+   * @brief Create the sum of the "left" and "right" spline asynchronously.
+   *
+   * @tparam Interp type of interpolation.
+   * @param left left spline summand.
+   * @param right right spline summand.
+   * @param accScale accepted difference between the splines' basis scaling.
+   * @param accBps tolerance for assigning knots to breakpoint.
+   * @return Future<Spline> representation of spline sum.
+   */
+  template <typename Interp = Interpolate>
+  static Future<Spline> add(const Spline &left, const Spline &right,
+                            double accScale = 1e-6, double accBps = 1e-6) {
+    return launch([left{copySpline(left)}, right{copySpline(right)}, accScale,
+                   accBps]() {
+      return left.add<Interp>(right, accScale, accBps);
+    });
+  }
+
+  /**
+   * @brief Create the product of the "left" and "right" spline
+   * asynchronously.
+   *
+   * @tparam Interp type of interpolation.
+   * @param left left product spline.
+   * @param right right product spline.
+   * @param accScale accepted difference between the splines' basis scaling.
+   * @param accBps tolerance for assigning knots to breakpoint.
+   * @return Future<Spline> representation of spline product.
+   */
+  template <typename Interp = Interpolate>
+  static Future<Spline> prod(const Spline &left, const Spline &right,
+                             double accScale = 1e-6, double accBps = 1e-6) {
+    return launch([left{copySpline(left)}, right{copySpline(right)}, accScale,
+                   accBps]() {
+      return left.prod<Interp>(right, accScale, accBps);
+    });
+  }
+
+  /**
+   * @brief Get the roots of the "spline" along all output dimensions
+   * asynchronously.
+   *
+   * @param spline spline to find the roots of.
+   * @param maxIter Maximum number of iterations.
+   * @param accAbs Tolerance for the spline output to be considered zero.
+   * @return Future<std::vector<Eigen::ArrayXd>> roots along all output
+   * dimensions.
+   */
+  static Future<std::vector<Eigen::ArrayXd>>
+  getRoots(const Spline &spline, int maxIter = 10, double accAbs = 1e-6) {
+    return launch([spline{copySpline(spline)}, maxIter, accAbs]() {
+      return spline.getRoots(maxIter, accAbs);
+    });
+  }
+
+private:
+  // MARK: private methods
+
+  /**
+   * @brief Copy the "basis" into a new basis not shared with the caller.
+   *
+   * @param basis basis to copy.
+   * @return std::shared_ptr<Basis> copy of "basis".
+   */
+  static std::shared_ptr<Basis>
+  copyBasis(const std::shared_ptr<Basis> &basis) {
+    return std::make_shared<Basis>(*basis);
+  }
+
+  /**
+   * @brief Copy the "spline" with a copy of its basis, see Async::copyBasis.
+   *
+   * @param spline spline to copy.
+   * @return Spline copy of "spline".
+   */
+  static Spline copySpline(const Spline &spline) {
+    return {copyBasis(spline.basis()), spline.getCoefficients()};
+  }
+};
+}; // namespace BasisSplines
+
+#endif
@@ -3,10 +3,18 @@
 
 #include <Eigen/Core>
 #include <Eigen/Dense>
-#include <numeric>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <memory_resource>
+#include <numeric>
 
+#include "basisSplines/executor.h"
 #include "basisSplines/math.h"
+#include "basisSplines/splineWorkspace.h"
 
 namespace BasisSplines {
 
@@ -34,8 +42,48 @@ public:
    * @param order basis order.
    * @param scale knot scaling factor.
    */
-  Basis(const Eigen::ArrayXd &knots, int order, double scale = 1.0)
-      : m_knots{knots}, m_order{order}, m_scale{scale} {}
+  Basis(Eigen::ArrayXd knots, int order, double scale = 1.0)
+      : m_knots{std::move(knots)}, m_order{order}, m_scale{scale} {}
+
+  /**
+   * @brief Test equality of order, scale and knots with "other" basis.
+   * Identical objects and bases with different hashes are decided without
+   * comparing the knots.
+   *
+   * @param other basis to compare.
+   * @return true bases are equal.
+   * @return false bases differ.
+   */
+  bool operator==(const Basis &other) const {
+    if (this == &other)
+      return true;
+    if (m_hash != other.m_hash || m_order != other.m_order ||
+        m_scale != other.m_scale || m_knots.size() != other.m_knots.size())
+      return false;
+    return (m_knots == other.m_knots).all();
+  }
+
+  /**
+   * @brief Get the hash of order, scale and knots.
+   * The hash is computed from the value bits when the basis changes and
+   * coincides for equal bases.
+   *
+   * @return size_t basis hash.
+   */
+  size_t hash() const { return m_hash; }
+
+  /**
+   * @brief Determine the hash of order, scale and knots, with knots rounded to
+   * multiples of "accKnots". Knots differing by less than "accKnots" only have
+   * different hashes if they are rounded to different multiples.
+   *
+   * @param accKnots knot quantisation step.
+   * @return size_t basis hash with quantised knots.
+   */
+  size_t hash(double accKnots) const {
+    assert(accKnots > 0.0 && "Knot quantisation step must be positive.");
+    return computeHash(accKnots);
+  }
 
   /**
    * @brief Create a new basis with knots including "knotsIn" and "this" basis
@@ -51,14 +99,14 @@ public:
 
     // sort for increasing knot sequence
     std::sort(knotsNew.begin(), knotsNew.end());
-    return {knotsNew, order()};
+    return {std::move(knotsNew), order()};
   }
 
   /**
    * @brief Combine the knots of "this" and another "basis" to new
    * basis of given "order" [Loo+15].
    * The "order" cannot subceed maximum of "this" and other "basis" order.   *
-   * The new basis retains the breakpoints of the source bases.
+   * The new basis retains the breakpoints of the source bases and their scale.
    *
    * @param basis other basis to combine with.
    * @param order result basis order.
@@ -74,6 +122,10 @@ public:
     assert(order >= std::max(m_order, basis.order()) &&
            "New basis cannot subceed maximum of this and other bases order.");
 
+    // equal bases, e.g. retimed by the same affine map, combine to themselves
+    if (order == m_order && *this == basis)
+      return *this;
+
     // create this and other bases knots considering target order
     Eigen::ArrayXd knotsThis{toKnots(getBreakpoints(accBps), order)};
     Eigen::ArrayXd knotsOther{toKnots(basis.getBreakpoints(accBps), order)};
@@ -118,7 +170,7 @@ public:
       ++numKnotsComb;
     }
 
-    return {knotsComb(Eigen::seqN(0, numKnotsComb)), order};
+    return {knotsComb(Eigen::seqN(0, numKnotsComb)), order, m_scale};
   }
 
   /**
@@ -161,7 +213,7 @@ public:
         Eigen::ArrayXd::Zero(change) + *(knots().end() - 1);
 
     // create basis of higher order
-    return {knotsNew, order() + change};
+    return {std::move(knotsNew), order() + change};
   }
 
   /**
@@ -182,7 +234,7 @@ public:
     Eigen::ArrayXd knotsNew{toKnots(getBreakpoints(), m_order + change)};
 
     // create basis of higher order
-    return {knotsNew, order() + change};
+    return {std::move(knotsNew), order() + change};
   }
 
   /**
@@ -219,7 +271,7 @@ public:
 
     // base case order 1 derivative
     if (orderDer == 1) {
-      basis = basisDeriv;
+      basis = std::move(basisDeriv);
       return transform;
     }
 
@@ -261,7 +313,7 @@ public:
 
     // base case order 1 derivative
     if (orderDer == 1) {
-      basis = basisDeriv;
+      basis = std::move(basisDeriv);
       return valuesNew;
     }
 
@@ -307,7 +359,7 @@ public:
 
     // base case order 1 integral
     if (orderInt == 1) {
-      basis = basisDeriv;
+      basis = std::move(basisDeriv);
       return transform;
     }
 
@@ -350,7 +402,7 @@ public:
 
     // base case order 1 integral
     if (orderInt == 1) {
-      basis = basisInt;
+      basis = std::move(basisInt);
       return valuesNew;
     }
 
@@ -366,14 +418,18 @@ public:
    *
    * @param basis right operand basis.
    * @param basisOut sum basis.
+   * @param accScale accepted difference between "this" and "basis" scaling.
+   * @param accBps tolerance for assigning knots to breakpoint.
    * @return std::pair<Eigen::MatrixXd, Eigen::MatrixXd> transformation matrices
    * Tl and Tr.
    */
   template <typename Interp = Interpolate>
-  std::pair<Eigen::MatrixXd, Eigen::MatrixXd> add(const Basis &basis,
-                                                  Basis &basisOut) const {
+  std::pair<Eigen::MatrixXd, Eigen::MatrixXd>
+  add(const Basis &basis, Basis &basisOut, double accScale = 1e-6,
+      double accBps = 1e-6) const {
     // combine this and other basis to sum basis
-    basisOut = combine(basis, std::max(order(), basis.order()));
+    basisOut =
+        combine(basis, std::max(order(), basis.order()), accScale, accBps);
 
     // instantiate interpolate with sum basis
     const Interp interp{std::make_shared<Basis>(basisOut)};
@@ -388,7 +444,7 @@ public:
       return values;
     })};
 
-    return {transformThis, transformOther};
+    return {std::move(transformThis), std::move(transformOther)};
   }
 
   /**
@@ -399,12 +455,15 @@ public:
    *
    * @param basis right operand basis.
    * @param basisOut product basis.
+   * @param accScale accepted difference between "this" and "basis" scaling.
+   * @param accBps tolerance for assigning knots to breakpoint.
    * @return Eigen::MatrixXd transformation matrix T.
    */
   template <typename Interp = Interpolate>
-  Eigen::MatrixXd prod(const Basis &basis, Basis &basisOut) const {
+  Eigen::MatrixXd prod(const Basis &basis, Basis &basisOut,
+                       double accScale = 1e-6, double accBps = 1e-6) const {
     // combine this and other basis to sum basis
-    basisOut = combine(basis, order() + basis.order() - 1);
+    basisOut = combine(basis, order() + basis.order() - 1, accScale, accBps);
 
     // instantiate interpolate with sum basis
     const Interp interp{std::make_shared<Basis>(basisOut)};
@@ -438,6 +497,72 @@ public:
    */
   const Eigen::ArrayXd &knots() const { return m_knots; }
 
+  /**
+   * @brief Determine the knot span ["knots(span)", "knots(span + 1)"]
+   * containing "point".
+   *
+   * The spans are closed on the right except for the first non-empty span,
+   * which also contains its left end. Points up to "accSegment" outside the
+   * knots are assigned to the first or last non-empty span. The span is found
+   * with the span index if enabled with Basis::setSpanIndex and otherwise by a
+   * binary search on the knots.
+   *
+   * @param point query point.
+   * @param accSegment accuracy for assigning points outside the knots.
+   * @return int index of the first span knot or -1 if "point" is outside the
+   * knots.
+   */
+  int getSpan(double point, double accSegment = 1e-6) const {
+    const Eigen::Index numKnots{m_knots.size()};
+    if (point < m_knots(0) - accSegment ||
+        point > m_knots(numKnots - 1) + accSegment)
+      return -1;
+
+    if (!m_spanIndex)
+      return getSpan(m_knots, point, accSegment);
+
+    // first knot not less than point limited to non-empty spans
+    const Eigen::Index knotIdx{findKnot(point, *m_spanIndex)};
+    auto [spanFirst, spanLast] = getSpanLimits(m_knots);
+    return static_cast<int>(
+        std::clamp<Eigen::Index>(knotIdx - 1, spanFirst, spanLast));
+  }
+
+  /**
+   * @brief Evaluate the basis functions that are non-zero on the knot "span"
+   * at "point". The values are computed with the recursion of
+   * Basis::operator() restricted to the functions non-zero on the span.
+   *
+   * The i-th value corresponds with the basis function "span - order + 1 + i".
+   * Values of functions outside the basis are zero.
+   *
+   * @param point evaluation point.
+   * @param span knot span containing "point", see Basis::getSpan.
+   * @param values "order" basis values.
+   * @param accBps minimum distance between breakpoints.
+   */
+  void evalSpan(double point, int span, Eigen::Ref<Eigen::VectorXd> values,
+                double accBps = 1e-6) const {
+    evalSpan(m_knots, m_order, point, span, values, accBps);
+  }
+
+  /**
+   * @brief Enable or disable the span index for Basis::getSpan.
+   *
+   * The index divides the knot range into uniform buckets, which store the
+   * first knot not less than the bucket's left end. A lookup maps the point to
+   * its bucket and finishes with a short search in the bucket. The index is
+   * built once when enabled and gives expected constant lookup time for
+   * arbitrary knot distributions.
+   *
+   * @param bucketsPerKnot number of buckets per knot, 0 disables the index.
+   */
+  void setSpanIndex(int bucketsPerKnot = 2) {
+    assert(bucketsPerKnot >= 0 && "Number of buckets must be positive.");
+    m_spanIndexBuckets = bucketsPerKnot;
+    m_spanIndex = bucketsPerKnot > 0 ? buildSpanIndex() : nullptr;
+  }
+
   /**
    * @brief Set breakpoints at given breakpoint indices.
    *
@@ -455,6 +580,8 @@ public:
           "Breakpoints not aranged in strictly increasing order.");
 
     m_knots = toKnots({breakpoints, conts}, m_order);
+    m_hash = computeHash();
+    setSpanIndex(m_spanIndexBuckets);
   }
 
   /**
@@ -481,7 +608,44 @@ public:
    *
    * @param scale scaling fator.
    */
-  void setScale(double scale) { m_scale = scale; }
+  void setScale(double scale) {
+    m_scale = scale;
+    m_hash = computeHash();
+  }
+
+  /**
+   * @brief Create a new basis with knots mapped by t -> "factor" * t +
+   * "offset". A spline with the new basis and the same coefficients is the
+   * retimed spline s(("t" - "offset") / "factor"). Derivative and integral
+   * transforms follow from the mapped knot differences, such that they scale
+   * with 1 / "factor" and "factor" per order.
+   *
+   * @param factor positive factor of the knots.
+   * @param offset offset of the knots.
+   * @return Basis basis with mapped knots.
+   */
+  Basis affine(double factor, double offset) const & {
+    Basis basis{*this};
+    return std::move(basis).affine(factor, offset);
+  }
+
+  /**
+   * @brief Map the knots of "this" basis by t -> "factor" * t + "offset" in
+   * place and move "this" basis into the result, see Basis::affine.
+   *
+   * @param factor positive factor of the knots.
+   * @param offset offset of the knots.
+   * @return Basis basis with mapped knots.
+   */
+  Basis affine(double factor, double offset) && {
+    if (!(factor > 0.0))
+      throw std::invalid_argument("Affine factor must be positive.");
+
+    m_knots = factor * m_knots + offset;
+    m_hash = computeHash();
+    setSpanIndex(m_spanIndexBuckets);
+    return std::move(*this);
+  }
 
   /**
    * @brief Evaluate the truncated power basis at the given "points".
@@ -501,50 +665,56 @@ public:
     // stores evaluation of truncated powers at given points
     Eigen::MatrixXd basisValues{Eigen::MatrixXd::Zero(points.size(), dim())};
 
-    // evaluate trunctated powers for each point
-    int cPoint{};
-    for (double point : points) {
-      // each VectorXd stores values of bases of increasing order
-      std::vector<Eigen::VectorXd> basesValues(m_order);
-
-      // evaluate basis of order 1 which is eiter 1.0 or 0.0
-      basesValues[0].resize(m_knots.size() - 1);
-      for (int cKnot{}; cKnot < m_knots.size() - 1; ++cKnot)
-        basesValues[0](cKnot) =
-            inKnotSeg(m_knots(cKnot), m_knots(cKnot + 1), point, accSegment)
-                ? 1.0
-                : 0.0;
-
-      // evaluate bases of order > 1 in ascending order
-      for (int cOrder{2}; cOrder <= m_order; ++cOrder) {
-        // get basis values of next higher order as weighted sum of neighboring
-        // basis values
-        for (int cKnot{}; cKnot < m_knots.size() - cOrder; ++cKnot) {
-          // determine basis weight based on current knot
-          const double denumCurr{m_knots(cKnot + cOrder - 1) - m_knots(cKnot)};
-          const double weightCurr{std::abs(denumCurr) > accBps
-                                      ? (point - m_knots(cKnot)) / denumCurr
-                                      : 0.0};
-
-          // determine basis weight based on next knot
-          const double denumNext{m_knots(cKnot + cOrder) - m_knots(cKnot + 1)};
-          const double weightNext{std::abs(denumNext) > accBps
-                                      ? (m_knots(cKnot + cOrder) - point) /
-                                            denumNext
-                                      : 0.0};
-
-          // basis value of higher order
-          basesValues[cOrder - 1].resize(m_knots.size() - cOrder);
-          basesValues[cOrder - 1](cKnot) =
-              weightCurr * basesValues[cOrder - 2](cKnot) +
-              weightNext * basesValues[cOrder - 2](cKnot + 1);
+    // evaluate chunks of points in parallel, see Executor
+    Executor::parallelFor(0, points.size(), [&](Eigen::Index begin,
+                                                Eigen::Index end) {
+      // values of bases of increasing order are computed in place, since the
+      // value of a function only depends on itself and its right neighbor
+      std::pmr::vector<double> basesValues(m_knots.size() - 1,
+                                           SplineWorkspace::resource());
+
+      // evaluate trunctated powers for each point
+      for (Eigen::Index cPoint{begin}; cPoint < end; ++cPoint) {
+        const double point{points(cPoint)};
+
+        // evaluate basis of order 1 which is eiter 1.0 or 0.0
+        for (int cKnot{}; cKnot < m_knots.size() - 1; ++cKnot)
+          basesValues[cKnot] =
+              inKnotSeg(m_knots(cKnot), m_knots(cKnot + 1), point, accSegment)
+                  ? 1.0
+                  : 0.0;
+
+        // evaluate bases of order > 1 in ascending order
+        for (int cOrder{2}; cOrder <= m_order; ++cOrder) {
+          // get basis values of next higher order as weighted sum of
+          // neighboring basis values
+          for (int cKnot{}; cKnot < m_knots.size() - cOrder; ++cKnot) {
+            // determine basis weight based on current knot
+            const double denumCurr{m_knots(cKnot + cOrder - 1) -
+                                   m_knots(cKnot)};
+            const double weightCurr{std::abs(denumCurr) > accBps
+                                        ? (point - m_knots(cKnot)) / denumCurr
+                                        : 0.0};
+
+            // determine basis weight based on next knot
+            const double denumNext{m_knots(cKnot + cOrder) -
+                                   m_knots(cKnot + 1)};
+            const double weightNext{std::abs(denumNext) > accBps
+                                        ? (m_knots(cKnot + cOrder) - point) /
+                                              denumNext
+                                        : 0.0};
+
+            // basis value of higher order
+            basesValues[cKnot] = weightCurr * basesValues[cKnot] +
+                                 weightNext * basesValues[cKnot + 1];
+          }
         }
-      }
 
-      // store maximum order basis values for current point
-      basisValues(cPoint++, Eigen::seqN(0, dim())) =
-          basesValues[m_order - 1](Eigen::seqN(0, dim()));
-    }
+        // store maximum order basis values for current point
+        for (int cBasis{}; cBasis < dim(); ++cBasis)
+          basisValues(cPoint, cBasis) = basesValues[cBasis];
+      }
+    });
 
     return basisValues;
   }
@@ -620,7 +790,7 @@ public:
     for (; begin < end; ++begin)
       knots(cElem++) = *begin;
 
-    return {knots, m_order};
+    return {std::move(knots), m_order};
   }
 
   /**
@@ -669,11 +839,117 @@ public:
     knots(Eigen::seqN(knots.size() - m_order, m_order)) =
         knots(knots.size() - m_order);
 
-    return {knots, m_order};
+    return {std::move(knots), m_order};
   }
 
   // MARK: public statics
 
+  /**
+   * @brief Determine the knot span of "point" for the given "knots" by a
+   * binary search, see Basis::getSpan.
+   *
+   * @tparam Derived type of the knot array.
+   * @param knots knot locations.
+   * @param point query point.
+   * @param accSegment accuracy for assigning points outside the knots.
+   * @return int index of the first span knot or -1 if "point" is outside the
+   * knots.
+   */
+  template <typename Derived>
+  static int getSpan(const Eigen::ArrayBase<Derived> &knots, double point,
+                     double accSegment = 1e-6) {
+    const Eigen::Index numKnots{knots.size()};
+    if (point < knots(0) - accSegment ||
+        point > knots(numKnots - 1) + accSegment)
+      return -1;
+
+    // first knot not less than point
+    const Eigen::Index knotIdx{
+        std::lower_bound(knots.begin(), knots.end(), point) - knots.begin()};
+
+    // limit to non-empty spans
+    auto [spanFirst, spanLast] = getSpanLimits(knots);
+    return static_cast<int>(
+        std::clamp<Eigen::Index>(knotIdx - 1, spanFirst, spanLast));
+  }
+
+  /**
+   * @brief Evaluate the basis functions of "order" and "knots" that are
+   * non-zero on the knot "span" at "point", see Basis::evalSpan.
+   *
+   * @tparam Derived type of the knot array.
+   * @param knots knot locations.
+   * @param order basis order.
+   * @param point evaluation point.
+   * @param span knot span containing "point".
+   * @param values "order" basis values.
+   * @param accBps minimum distance between breakpoints.
+   */
+  template <typename Derived>
+  static void evalSpan(const Eigen::ArrayBase<Derived> &knots, int order,
+                       double point, int span,
+                       Eigen::Ref<Eigen::VectorXd> values,
+                       double accBps = 1e-6) {
+    assert(values.size() == order && "Values size must equal basis order.");
+
+    // order 1 basis value is 1.0 on span
+    values.setZero();
+    values(order - 1) = 1.0;
+
+    const int numKnots{static_cast<int>(knots.size())};
+    const int first{span - order + 1};
+    for (int cOrder{2}; cOrder <= order; ++cOrder) {
+      for (int cKnot{span - cOrder + 1}; cKnot <= span; ++cKnot) {
+        const int idx{cKnot - first};
+
+        // basis function does not exist for given knots
+        if (cKnot < 0 || cKnot > numKnots - cOrder - 1) {
+          values(idx) = 0.0;
+          continue;
+        }
+
+        // determine basis weight based on current knot
+        const double denumCurr{knots(cKnot + cOrder - 1) - knots(cKnot)};
+        const double weightCurr{std::abs(denumCurr) > accBps
+                                    ? (point - knots(cKnot)) / denumCurr
+                                    : 0.0};
+
+        // determine basis weight based on next knot
+        const double denumNext{knots(cKnot + cOrder) - knots(cKnot + 1)};
+        const double weightNext{std::abs(denumNext) > accBps
+                                    ? (knots(cKnot + cOrder) - point) /
+                                          denumNext
+                                    : 0.0};
+
+        values(idx) = weightCurr * values(idx) +
+                      (idx + 1 < order ? weightNext * values(idx + 1) : 0.0);
+      }
+    }
+  }
+
+  /**
+   * @brief Determine the first and last non-empty knot spans of "knots".
+   *
+   * @tparam Derived type of the knot array.
+   * @param knots knot locations.
+   * @return std::pair<Eigen::Index, Eigen::Index> first and last non-empty
+   * span.
+   */
+  template <typename Derived>
+  static std::pair<Eigen::Index, Eigen::Index>
+  getSpanLimits(const Eigen::ArrayBase<Derived> &knots) {
+    Eigen::Index spanFirst{};
+    while (spanFirst < knots.size() - 2 &&
+           knots(spanFirst) >= knots(spanFirst + 1))
+      ++spanFirst;
+
+    Eigen::Index spanLast{knots.size() - 2};
+    while (spanLast > spanFirst && knots(spanLast) >= knots(spanLast + 1))
+      --spanLast;
+
+    return {spanFirst, spanLast};
+  }
+
   /**
    * @brief Map "breakpoints" and "continuities" to knots [Boo01, th. (44)].
    *
@@ -763,9 +1039,34 @@ private:
   Eigen::ArrayXd m_knots; /**<< basis knots m_knots(i) <= m_knots(i+1) */
   int m_order{};          /**<< basis order = degree - 1 */
   double m_scale{};       /**<< scaling factor for m_knots */
+  int m_spanIndexBuckets{}; /**<< number of span index buckets per knot */
+  std::shared_ptr<const Eigen::ArrayXi>
+      m_spanIndex{}; /**<< first knot index per span index bucket */
+  size_t m_hash{computeHash()}; /**<< hash of order, scale and knots */
 
   // MARK: private methods
 
+  /**
+   * @brief Determine the hash of order, scale and knots. The knots are
+   * rounded to multiples of "accKnots" if positive.
+   *
+   * @param accKnots knot quantisation step.
+   * @return size_t basis hash.
+   */
+  size_t computeHash(double accKnots = 0.0) const {
+    size_t hash{std::hash<int>{}(m_order)};
+    const auto combine{[&hash](double value) {
+      // identical hash for positive and negative zero
+      value = value == 0.0 ? 0.0 : value;
+      hash ^= std::hash<uint64_t>{}(std::bit_cast<uint64_t>(value)) +
+              0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+    }};
+    combine(m_scale);
+    for (double knot : m_knots)
+      combine(accKnots > 0.0 ? std::round(knot / accKnots) : knot);
+    return hash;
+  }
+
   /**
    * @brief Test if "point" is in a knot segment ["knotL" - "accPoint", "knotR"
    * + "accPoint"].
@@ -794,6 +1095,69 @@ private:
     return point > knotL && point <= knotR;
   }
 
+  /**
+   * @brief Build the span index with "m_spanIndexBuckets" uniform buckets per
+   * knot. Each entry stores the first knot not less than the left bucket end.
+   * The last entry stores the number of knots.
+   *
+   * @return std::shared_ptr<const Eigen::ArrayXi> span index.
+   */
+  std::shared_ptr<const Eigen::ArrayXi> buildSpanIndex() const {
+    const int numBuckets{m_spanIndexBuckets * static_cast<int>(m_knots.size())};
+    const double first{m_knots(0)};
+    const double width{(m_knots(m_knots.size() - 1) - first) / numBuckets};
+
+    auto spanIndex{std::make_shared<Eigen::ArrayXi>(numBuckets + 1)};
+    Eigen::Index knotIdx{};
+    for (int cBucket{}; cBucket < numBuckets; ++cBucket) {
+      while (knotIdx < m_knots.size() &&
+             m_knots(knotIdx) < first + cBucket * width)
+        ++knotIdx;
+      (*spanIndex)(cBucket) = static_cast<int>(knotIdx);
+    }
+    (*spanIndex)(numBuckets) = static_cast<int>(m_knots.size());
+
+    return spanIndex;
+  }
+
+  /**
+   * @brief Find the first knot not less than "point" with the "spanIndex".
+   * The search starts at the bucket's first knot and continues linearly for
+   * sparse buckets or with a binary search for dense buckets.
+   *
+   * @param point query point.
+   * @param spanIndex span index.
+   * @return Eigen::Index index of the first knot not less than "point".
+   */
+  Eigen::Index findKnot(double point, const Eigen::ArrayXi &spanIndex) const {
+    const int numBuckets{static_cast<int>(spanIndex.size()) - 1};
+    const double first{m_knots(0)};
+    const double range{m_knots(m_knots.size() - 1) - first};
+
+    const int bucket{std::clamp(
+        range > 0.0 ? static_cast<int>((point - first) / range * numBuckets)
+                    : 0,
+        0, numBuckets - 1)};
+
+    Eigen::Index knotIdx{spanIndex(bucket)};
+    const Eigen::Index knotEnd{spanIndex(bucket + 1)};
+
+    // correct rounding of the bucket assignment
+    while (knotIdx > 0 && m_knots(knotIdx - 1) >= point)
+      --knotIdx;
+
+    // dense bucket: binary search
+    if (knotEnd - knotIdx > 8)
+      knotIdx = std::lower_bound(m_knots.begin() + knotIdx,
+                                 m_knots.begin() + knotEnd, point) -
+                m_knots.begin();
+
+    // sparse bucket: linear search
+    while (knotIdx < m_knots.size() && m_knots(knotIdx) < point)
+      ++knotIdx;
+    return knotIdx;
+  }
+
   // MARK: private statics
 
   /**
@@ -813,4 +1177,14 @@ private:
 };
 }; // namespace BasisSplines
 
+/**
+ * @brief Hash of a basis for unordered containers.
+ *
+ */
+template <> struct std::hash<BasisSplines::Basis> {
+  size_t operator()(const BasisSplines::Basis &basis) const {
+    return basis.hash();
+  }
+};
+
 #endif
\ No newline at end of file
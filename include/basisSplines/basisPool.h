@@ -0,0 +1,206 @@
+#ifndef BASIS_POOL_H
+#define BASIS_POOL_H
+
+#include <Eigen/Core>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "basisSplines/basis.h"
+
+namespace BasisSplines {
+
+/**
+ * @brief Pool of canonical bases shared by splines with identical bases.
+ *
+ * Bases with equal order, scale and knots are interned to a single
+ * std::shared_ptr<Basis>. The pool only holds weak references, such that
+ * bases are released once no spline uses them. The global pool is disabled by
+ * default. If enabled, all derived splines, e.g. by Spline::derivative or
+ * Spline::add, obtain their basis from the global pool. Interned bases are
+ * shared and must not be modified.
+ *
+ * Expired references are removed on lookup of their hash and by a full sweep
+ * whenever the number of entries doubled since the last sweep. The number of
+ * entries is thus at most twice the number of used bases plus a constant, at
+ * amortised constant cost per insertion.
+ */
+class BasisPool {
+public:
+  // MARK: public methods
+
+  /**
+   * @brief Get the global pool of bases.
+   *
+   * @return BasisPool& global pool.
+   */
+  static BasisPool &global() {
+    static BasisPool pool{};
+    return pool;
+  }
+
+  /**
+   * @brief Enable or disable interning derived bases in the global pool.
+   *
+   * @param enabled derived bases are interned.
+   */
+  static void setEnabled(bool enabled) { s_enabled = enabled; }
+
+  /**
+   * @brief Determine if derived bases are interned in the global pool.
+   *
+   * @return true derived bases are interned.
+   * @return false derived bases are not interned.
+   */
+  static bool isEnabled() { return s_enabled; }
+
+  /**
+   * @brief Create a shared basis from "basis". The basis is interned in the
+   * global pool if enabled.
+   *
+   * @param basis basis to share.
+   * @return std::shared_ptr<Basis> shared basis.
+   */
+  static std::shared_ptr<Basis> makeBasis(Basis basis) {
+    if (!s_enabled)
+      return std::make_shared<Basis>(std::move(basis));
+    return global().intern(std::move(basis));
+  }
+
+  /**
+   * @brief Get the canonical basis equal to "basis". If the pool contains no
+   * equal basis, "basis" becomes the canonical basis.
+   *
+   * @param basis basis to intern.
+   * @return std::shared_ptr<Basis> canonical basis.
+   */
+  std::shared_ptr<Basis> intern(Basis basis) {
+    const size_t hash{basis.hash()};
+    std::lock_guard<std::mutex> lock{m_mutex};
+
+    if (std::shared_ptr<Basis> canonical{find(basis, hash)})
+      return canonical;
+
+    std::shared_ptr<Basis> canonical{std::make_shared<Basis>(std::move(basis))};
+    insert(hash, canonical);
+    return canonical;
+  }
+
+  /**
+   * @brief Get the canonical basis equal to "basis". If the pool contains no
+   * equal basis, "basis" becomes the canonical basis.
+   *
+   * @param basis basis to intern.
+   * @return std::shared_ptr<Basis> canonical basis.
+   */
+  std::shared_ptr<Basis> intern(const std::shared_ptr<Basis> &basis) {
+    const size_t hash{basis->hash()};
+    std::lock_guard<std::mutex> lock{m_mutex};
+
+    if (std::shared_ptr<Basis> canonical{find(*basis, hash)})
+      return canonical;
+
+    insert(hash, basis);
+    return basis;
+  }
+
+  /**
+   * @brief Get the number of bases in the pool, which are used by any
+   * spline.
+   *
+   * @return size_t number of pooled bases.
+   */
+  size_t size() {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    prune();
+    return m_bases.size();
+  }
+
+  /**
+   * @brief Get the number of entries in the pool including expired ones,
+   * which are not yet removed.
+   *
+   * @return size_t number of entries.
+   */
+  size_t getNumEntries() {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return m_bases.size();
+  }
+
+  /**
+   * @brief Remove all bases from the pool.
+   *
+   */
+  void clear() {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_bases.clear();
+    m_numPrune = s_minNumPrune;
+  }
+
+private:
+  // MARK: private properties
+
+  static inline std::atomic<bool> s_enabled{}; /**<< global pool is enabled */
+  static constexpr size_t s_minNumPrune{64}; /**<< minimum entries to sweep */
+
+  std::mutex m_mutex{}; /**<< guards the pooled bases */
+  std::unordered_multimap<size_t, std::weak_ptr<Basis>>
+      m_bases{}; /**<< pooled bases by hash */
+  size_t m_numPrune{s_minNumPrune}; /**<< number of entries of next sweep */
+
+  // MARK: private methods
+
+  /**
+   * @brief Add "basis" with the given "hash" to the pool. Expired bases are
+   * removed if the number of entries reaches twice the number after the last
+   * sweep.
+   *
+   * @param hash hash of "basis".
+   * @param basis basis to add.
+   */
+  void insert(size_t hash, const std::shared_ptr<Basis> &basis) {
+    m_bases.emplace(hash, basis);
+    if (m_bases.size() >= m_numPrune) {
+      prune();
+      m_numPrune = std::max(s_minNumPrune, 2 * m_bases.size());
+    }
+  }
+
+  /**
+   * @brief Remove all expired bases from the pool.
+   *
+   */
+  void prune() {
+    std::erase_if(m_bases, [](const auto &entry) {
+      return entry.second.expired();
+    });
+  }
+
+  /**
+   * @brief Find a pooled basis equal to "basis" with the given "hash" and
+   * remove expired bases with this hash.
+   *
+   * @param basis basis to find.
+   * @param hash hash of "basis".
+   * @return std::shared_ptr<Basis> equal pooled basis or nullptr.
+   */
+  std::shared_ptr<Basis> find(const Basis &basis, size_t hash) {
+    auto [entry, end] = m_bases.equal_range(hash);
+    while (entry != end) {
+      std::shared_ptr<Basis> pooled{entry->second.lock()};
+      if (!pooled) {
+        entry = m_bases.erase(entry);
+        continue;
+      }
+      if (*pooled == basis)
+        return pooled;
+      ++entry;
+    }
+    return nullptr;
+  }
+};
+}; // namespace BasisSplines
+
+#endif
@@ -0,0 +1,350 @@
+#ifndef CPU_DISPATCH_H
+#define CPU_DISPATCH_H
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+
+#if (defined(__GNUC__) || defined(__clang__)) &&                               \
+    (defined(__x86_64__) || defined(__i386__))
+#define BASIS_SPLINES_DISPATCH 1
+#else
+#define BASIS_SPLINES_DISPATCH 0
+#endif
+
+namespace BasisSplines {
+
+/**
+ * @brief Instruction set levels of the dispatched kernels.
+ *
+ */
+enum class Isa {
+  baseline, /**<< compile target, SSE2 on x86-64 */
+  avx2,     /**<< AVX2 with FMA */
+  avx512,   /**<< AVX-512 foundation */
+};
+
+namespace Kernels {
+
+/**
+ * @brief SIMD vector of "width" doubles. The vectors are GCC vector
+ * extensions, which are compiled to the instruction set of the enclosing
+ * function.
+ *
+ * @tparam width number of doubles.
+ */
+template <int width> struct Vec {
+  using type = double;
+};
+
+#if BASIS_SPLINES_DISPATCH
+template <> struct Vec<2> {
+  typedef double type __attribute__((vector_size(16)));
+};
+template <> struct Vec<4> {
+  typedef double type __attribute__((vector_size(32)));
+};
+template <> struct Vec<8> {
+  typedef double type __attribute__((vector_size(64)));
+};
+#define BASIS_SPLINES_INLINE inline __attribute__((always_inline))
+#else
+#define BASIS_SPLINES_INLINE inline
+#endif
+
+/**
+ * @brief Evaluate the spline with "knots" and column-major "coeffs" at the
+ * points "points(idcs)" on the knot "span" and store the values in the
+ * column-major "values" at the rows "idcs".
+ *
+ * The basis recursion of Basis::evalSpan is performed for "width" points at
+ * once. The order must not exceed CpuDispatch::s_maxOrder. The weights only
+ * depend on the knots, such that each recursion step is a vector multiply-add.
+ *
+ * @tparam width number of points per vector.
+ * @param knots basis knots.
+ * @param numKnots number of knots.
+ * @param order basis order.
+ * @param span knot span containing the points.
+ * @param coeffs spline coefficients.
+ * @param numCoeffs number of coefficient rows.
+ * @param dim number of coefficient columns.
+ * @param points evaluation points.
+ * @param idcs indices of the points on the span.
+ * @param numIdcs number of points on the span.
+ * @param values spline values.
+ * @param numValues number of value rows.
+ * @param accBps minimum distance between breakpoints.
+ */
+template <int width>
+BASIS_SPLINES_INLINE void
+evalSpan(const double *knots, int numKnots, int order, int span,
+         const double *coeffs, int numCoeffs, int dim, const double *points,
+         const int *idcs, int numIdcs, double *values, long numValues,
+         double accBps) {
+  using V = typename Vec<width>::type;
+  V basis[32];
+  const int first{span - order + 1};
+
+  for (int cIdx{}; cIdx < numIdcs; cIdx += width) {
+    // gather points, the last vector is padded with its last point
+    double lanes[width];
+    for (int cLane{}; cLane < width; ++cLane)
+      lanes[cLane] = points[idcs[std::min(cIdx + cLane, numIdcs - 1)]];
+    V point;
+    std::memcpy(&point, lanes, sizeof(V));
+
+    // order 1 basis value is 1.0 on span
+    for (int idx{}; idx < order - 1; ++idx)
+      basis[idx] = V{} + 0.0;
+    basis[order - 1] = V{} + 1.0;
+
+    for (int cOrder{2}; cOrder <= order; ++cOrder)
+      for (int cKnot{span - cOrder + 1}; cKnot <= span; ++cKnot) {
+        const int idx{cKnot - first};
+
+        // basis function does not exist for given knots
+        if (cKnot < 0 || cKnot > numKnots - cOrder - 1) {
+          basis[idx] = V{} + 0.0;
+          continue;
+        }
+
+        const double denumCurr{knots[cKnot + cOrder - 1] - knots[cKnot]};
+        const double denumNext{knots[cKnot + cOrder] - knots[cKnot + 1]};
+        const double invCurr{denumCurr > accBps || denumCurr < -accBps
+                                 ? 1.0 / denumCurr
+                                 : 0.0};
+        const double invNext{denumNext > accBps || denumNext < -accBps
+                                 ? 1.0 / denumNext
+                                 : 0.0};
+        V value{(point - knots[cKnot]) * invCurr * basis[idx]};
+        if (idx + 1 < order)
+          value += (knots[cKnot + cOrder] - point) * invNext * basis[idx + 1];
+        basis[idx] = value;
+      }
+
+    // linear combination of coefficients non-zero on span
+    const int numLanes{std::min(width, numIdcs - cIdx)};
+    for (int cDim{}; cDim < dim; ++cDim) {
+      const double *coeffsDim{coeffs + static_cast<long>(cDim) * numCoeffs};
+      V sum{V{} + 0.0};
+      for (int cFunc{std::max(-first, 0)};
+           cFunc < order && first + cFunc < numCoeffs; ++cFunc)
+        sum += coeffsDim[first + cFunc] * basis[cFunc];
+
+      std::memcpy(lanes, &sum, sizeof(V));
+      for (int cLane{}; cLane < numLanes; ++cLane)
+        values[static_cast<long>(cDim) * numValues + idcs[cIdx + cLane]] =
+            lanes[cLane];
+    }
+  }
+}
+
+/**
+ * @brief Multiply the "size" elements of "left" and "right" and store the
+ * products in "result".
+ *
+ * @tparam width number of elements per vector.
+ * @param left left factors.
+ * @param right right factors.
+ * @param result products.
+ * @param size number of elements.
+ */
+template <int width>
+BASIS_SPLINES_INLINE void mul(const double *left, const double *right,
+                              double *result, long size) {
+  using V = typename Vec<width>::type;
+  long idx{};
+  for (; idx + width <= size; idx += width) {
+    V valueL, valueR;
+    std::memcpy(&valueL, left + idx, sizeof(V));
+    std::memcpy(&valueR, right + idx, sizeof(V));
+    const V product{valueL * valueR};
+    std::memcpy(result + idx, &product, sizeof(V));
+  }
+  for (; idx < size; ++idx)
+    result[idx] = left[idx] * right[idx];
+}
+
+#if BASIS_SPLINES_DISPATCH
+// kernel clones compiled for the instruction set levels
+#define BASIS_SPLINES_CLONE(isa, name, width)                                  \
+  __attribute__((target(isa))) inline void evalSpan##name(                     \
+      const double *knots, int numKnots, int order, int span,                  \
+      const double *coeffs, int numCoeffs, int dim, const double *points,      \
+      const int *idcs, int numIdcs, double *values, long numValues,            \
+      double accBps) {                                                         \
+    evalSpan<width>(knots, numKnots, order, span, coeffs, numCoeffs, dim,      \
+                    points, idcs, numIdcs, values, numValues, accBps);         \
+  }                                                                            \
+  __attribute__((target(isa))) inline void mul##name(                          \
+      const double *left, const double *right, double *result, long size) {    \
+    mul<width>(left, right, result, size);                                     \
+  }
+
+BASIS_SPLINES_CLONE("avx2,fma", Avx2, 4)
+BASIS_SPLINES_CLONE("avx512f", Avx512, 8)
+#undef BASIS_SPLINES_CLONE
+#endif
+}; // namespace Kernels
+
+/**
+ * @brief Runtime selection of the instruction set level of the hot kernels.
+ *
+ * The kernels are compiled for each instruction set level, such that binaries
+ * built for a baseline target, e.g. Python wheels, use AVX2 or AVX-512 on
+ * supporting CPUs. The level is detected with CPUID at first use. The
+ * environment variable BASIS_SPLINES_ISA set to "baseline", "avx2" or "avx512"
+ * limits the level, e.g. for testing. Levels unsupported by the CPU are never
+ * selected. Dispatch is only available with GCC or Clang on x86.
+ */
+class CpuDispatch {
+public:
+  static constexpr int s_maxOrder{32}; /**<< maximum order of the kernels */
+
+  // MARK: public methods
+
+  /**
+   * @brief Get the highest instruction set level supported by the CPU.
+   *
+   * @return Isa supported instruction set level.
+   */
+  static Isa getSupported() {
+#if BASIS_SPLINES_DISPATCH
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+      return Isa::avx512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+      return Isa::avx2;
+#endif
+    return Isa::baseline;
+  }
+
+  /**
+   * @brief Get the instruction set level used by the kernels. The level is
+   * determined at the first call from the CPU and BASIS_SPLINES_ISA.
+   *
+   * @return Isa active instruction set level.
+   */
+  static Isa getActive() {
+    static const bool initialised{[]() {
+      Isa isa{getSupported()};
+      if (const char *env{std::getenv("BASIS_SPLINES_ISA")})
+        isa = std::min(isa, fromName(env));
+      s_active = isa;
+      return true;
+    }()};
+    (void)initialised;
+    return s_active;
+  }
+
+  /**
+   * @brief Set the instruction set level used by the kernels. The level is
+   * limited to the level supported by the CPU.
+   *
+   * @param isa requested instruction set level.
+   */
+  static void setActive(Isa isa) {
+    getActive();
+    s_active = std::min(isa, getSupported());
+  }
+
+  /**
+   * @brief Get the name of the instruction set level "isa".
+   *
+   * @param isa instruction set level.
+   * @return const char* name as accepted by BASIS_SPLINES_ISA.
+   */
+  static const char *getName(Isa isa) {
+    switch (isa) {
+    case Isa::avx512:
+      return "avx512";
+    case Isa::avx2:
+      return "avx2";
+    default:
+      return "baseline";
+    }
+  }
+
+  /**
+   * @brief Get the instruction set level of "name". Unknown names correspond
+   * with the baseline.
+   *
+   * @param name name of the instruction set level.
+   * @return Isa instruction set level.
+   */
+  static Isa fromName(std::string_view name) {
+    if (name == "avx512")
+      return Isa::avx512;
+    if (name == "avx2")
+      return Isa::avx2;
+    return Isa::baseline;
+  }
+
+  /**
+   * @brief Evaluate a spline at points on a knot span with the active
+   * instruction set level, see Kernels::evalSpan.
+   *
+   */
+  static void evalSpan(const double *knots, int numKnots, int order, int span,
+                       const double *coeffs, int numCoeffs, int dim,
+                       const double *points, const int *idcs, int numIdcs,
+                       double *values, long numValues, double accBps) {
+    assert(order <= s_maxOrder && "Order exceeds CpuDispatch::s_maxOrder.");
+    switch (getActive()) {
+#if BASIS_SPLINES_DISPATCH
+    case Isa::avx512:
+      return Kernels::evalSpanAvx512(knots, numKnots, order, span, coeffs,
+                                     numCoeffs, dim, points, idcs, numIdcs,
+                                     values, numValues, accBps);
+    case Isa::avx2:
+      return Kernels::evalSpanAvx2(knots, numKnots, order, span, coeffs,
+                                   numCoeffs, dim, points, idcs, numIdcs,
+                                   values, numValues, accBps);
+    default:
+      return Kernels::evalSpan<2>(knots, numKnots, order, span, coeffs,
+                                  numCoeffs, dim, points, idcs, numIdcs,
+                                  values, numValues, accBps);
+#else
+    default:
+      return Kernels::evalSpan<1>(knots, numKnots, order, span, coeffs,
+                                  numCoeffs, dim, points, idcs, numIdcs,
+                                  values, numValues, accBps);
+#endif
+    }
+  }
+
+  /**
+   * @brief Multiply elements with the active instruction set level, see
+   * Kernels::mul.
+   *
+   */
+  static void mul(const double *left, const double *right, double *result,
+                  long size) {
+    switch (getActive()) {
+#if BASIS_SPLINES_DISPATCH
+    case Isa::avx512:
+      return Kernels::mulAvx512(left, right, result, size);
+    case Isa::avx2:
+      return Kernels::mulAvx2(left, right, result, size);
+    default:
+      return Kernels::mul<2>(left, right, result, size);
+#else
+    default:
+      return Kernels::mul<1>(left, right, result, size);
+#endif
+    }
+  }
+
+private:
+  // MARK: private properties
+
+  static inline std::atomic<Isa> s_active{
+      Isa::baseline}; /**<< active instruction set level */
+};
+}; // namespace BasisSplines
+
+#endif
@@ -0,0 +1,590 @@
+#ifndef EXECUTOR_H
+#define EXECUTOR_H
+
+#include <Eigen/Core>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <stop_token>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef BASIS_SPLINES_OPENMP
+#include <omp.h>
+#endif
+
+// default number of threads of parallel loops, zero selects the hardware
+// concurrency
+#ifndef BASIS_SPLINES_DEFAULT_NUM_THREADS
+#define BASIS_SPLINES_DEFAULT_NUM_THREADS 1
+#endif
+
+namespace BasisSplines {
+
+/**
+ * @brief Thrown by the parallel loops of an operation whose cancellation was
+ * requested.
+ *
+ */
+class OperationCancelled : public std::runtime_error {
+public:
+  OperationCancelled() : std::runtime_error{"Operation was cancelled."} {}
+};
+
+/**
+ * @brief Pool of persistent worker threads executing the tasks of one job at a
+ * time. The calling thread participates in the job and the tasks are claimed
+ * one by one from a shared counter, such that faster threads take over the
+ * remaining tasks of slower threads.
+ *
+ */
+class ThreadPool {
+public:
+  // MARK: public methods
+
+  /**
+   * @brief Construct a new pool with "numWorkers" worker threads.
+   *
+   * @param numWorkers number of worker threads in addition to the caller.
+   */
+  explicit ThreadPool(int numWorkers) {
+    for (int cWorker{}; cWorker < numWorkers; ++cWorker)
+      m_workers.emplace_back([this]() { work(); });
+  }
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  /**
+   * @brief Stop and join the worker threads.
+   *
+   */
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock{m_mutex};
+      m_stop = true;
+    }
+    m_wake.notify_all();
+    for (std::thread &worker : m_workers)
+      worker.join();
+  }
+
+  /**
+   * @brief Execute "task" for the indices 0 to "numTasks" - 1 and return once
+   * all tasks are finished. The first exception thrown by a task is rethrown.
+   * If the pool executes a job of another thread, the tasks are executed by
+   * the calling thread only.
+   *
+   * @param numTasks number of tasks.
+   * @param task task to execute for each index.
+   */
+  void run(Eigen::Index numTasks,
+           const std::function<void(Eigen::Index)> &task) {
+    std::unique_lock<std::mutex> lockRun{m_runMutex, std::try_to_lock};
+    if (!lockRun.owns_lock()) {
+      for (Eigen::Index cTask{}; cTask < numTasks; ++cTask)
+        task(cTask);
+      return;
+    }
+
+    Job job{&task, numTasks};
+    {
+      std::lock_guard<std::mutex> lock{m_mutex};
+      m_job = &job;
+      ++m_generation;
+    }
+    m_wake.notify_all();
+
+    execute(job);
+
+    std::unique_lock<std::mutex> lock{m_mutex};
+    m_done.wait(lock, [this]() { return m_active == 0; });
+    m_job = nullptr;
+    lock.unlock();
+
+    if (job.error)
+      std::rethrow_exception(job.error);
+  }
+
+  /**
+   * @brief Get the number of worker threads.
+   *
+   * @return int number of worker threads.
+   */
+  int getNumWorkers() const { return static_cast<int>(m_workers.size()); }
+
+private:
+  /**
+   * @brief Tasks of a single call to ThreadPool::run.
+   *
+   */
+  struct Job {
+    const std::function<void(Eigen::Index)> *task{}; /**<< task per index */
+    Eigen::Index numTasks{};                         /**<< number of tasks */
+    std::atomic<Eigen::Index> next{};  /**<< index of next unclaimed task */
+    std::mutex errorMutex{};           /**<< guards the exception */
+    std::exception_ptr error{};        /**<< first exception of a task */
+  };
+
+  // MARK: private properties
+
+  std::vector<std::thread> m_workers{}; /**<< worker threads */
+  std::mutex m_runMutex{};              /**<< held by the running job */
+  std::mutex m_mutex{};                 /**<< guards the job state */
+  std::condition_variable m_wake{};     /**<< signals a new job or stop */
+  std::condition_variable m_done{};     /**<< signals a finished worker */
+  Job *m_job{};                         /**<< current job */
+  size_t m_generation{};                /**<< number of started jobs */
+  int m_active{};                       /**<< workers executing the job */
+  bool m_stop{};                        /**<< workers must terminate */
+
+  // MARK: private methods
+
+  /**
+   * @brief Claim and execute tasks of "job" until all tasks are claimed.
+   *
+   * @param job job to execute.
+   */
+  static void execute(Job &job) {
+    for (Eigen::Index cTask{job.next++}; cTask < job.numTasks;
+         cTask = job.next++) {
+      try {
+        (*job.task)(cTask);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock{job.errorMutex};
+        if (!job.error)
+          job.error = std::current_exception();
+        job.next = job.numTasks;
+      }
+    }
+  }
+
+  /**
+   * @brief Loop of a worker thread waiting for and executing jobs.
+   *
+   */
+  void work() {
+    size_t generation{};
+    for (;;) {
+      std::unique_lock<std::mutex> lock{m_mutex};
+      m_wake.wait(lock, [&]() {
+        return m_stop || (m_job && m_generation != generation);
+      });
+      if (m_stop)
+        return;
+      generation = m_generation;
+      Job &job{*m_job};
+      ++m_active;
+      lock.unlock();
+
+      execute(job);
+
+      lock.lock();
+      --m_active;
+      lock.unlock();
+      m_done.notify_all();
+    }
+  }
+};
+
+/**
+ * @brief Queue of independent tasks executed by persistent worker threads in
+ * the order of submission.
+ *
+ */
+class TaskQueue {
+public:
+  // MARK: public methods
+
+  /**
+   * @brief Construct a new queue with "numWorkers" worker threads.
+   *
+   * @param numWorkers number of worker threads.
+   */
+  explicit TaskQueue(int numWorkers) {
+    assert(numWorkers > 0 && "Number of workers must be positive.");
+    for (int cWorker{}; cWorker < numWorkers; ++cWorker)
+      m_workers.emplace_back([this]() { work(); });
+  }
+
+  TaskQueue(const TaskQueue &) = delete;
+  TaskQueue &operator=(const TaskQueue &) = delete;
+
+  /**
+   * @brief Execute the remaining tasks, then stop and join the worker threads.
+   *
+   */
+  ~TaskQueue() {
+    {
+      std::lock_guard<std::mutex> lock{m_mutex};
+      m_stop = true;
+    }
+    m_wake.notify_all();
+    for (std::thread &worker : m_workers)
+      worker.join();
+  }
+
+  /**
+   * @brief Append a "task" to the queue. The task must not throw.
+   *
+   * @param task task to execute by a worker thread.
+   */
+  void push(std::function<void()> task) {
+    {
+      std::lock_guard<std::mutex> lock{m_mutex};
+      m_tasks.push_back(std::move(task));
+    }
+    m_wake.notify_one();
+  }
+
+private:
+  // MARK: private properties
+
+  std::vector<std::thread> m_workers{};        /**<< worker threads */
+  std::mutex m_mutex{};                        /**<< guards the tasks */
+  std::condition_variable m_wake{};            /**<< signals a task or stop */
+  std::deque<std::function<void()>> m_tasks{}; /**<< pending tasks */
+  bool m_stop{};                               /**<< workers must terminate */
+
+  // MARK: private methods
+
+  /**
+   * @brief Loop of a worker thread executing tasks until the queue is stopped
+   * and empty.
+   *
+   */
+  void work() {
+    for (;;) {
+      std::unique_lock<std::mutex> lock{m_mutex};
+      m_wake.wait(lock, [this]() { return m_stop || !m_tasks.empty(); });
+      if (m_tasks.empty())
+        return;
+      const std::function<void()> task{std::move(m_tasks.front())};
+      m_tasks.pop_front();
+      lock.unlock();
+
+      task();
+    }
+  }
+};
+
+/**
+ * @brief Library-wide configuration of parallel loops.
+ *
+ * Parallel evaluation, fitting and root-finding paths split their work into
+ * chunks with Executor::parallelFor. The chunks are executed by the internal
+ * ThreadPool, by OpenMP if compiled with BASIS_SPLINES_OPENMP, or by a
+ * user-supplied backend. With a single thread, all loops run serially on the
+ * calling thread. By default, loops run serially, such that the library does
+ * not oversubscribe threaded applications. More threads are requested by
+ * Executor::setNumThreads, the environment variable BASIS_SPLINES_NUM_THREADS
+ * or the CMake variable DEFAULT_NUM_THREADS. Loops nested in a
+ * parallel loop run serially. Changing the configuration affects subsequent
+ * loops only, running loops finish with their previous pool.
+ *
+ * Independent tasks, e.g. asynchronous operations, are submitted to a
+ * background TaskQueue with Executor::submit. Parallel loops executed within
+ * Executor::withStopToken throw OperationCancelled once a stop is requested.
+ */
+class Executor {
+public:
+  /**
+   * @brief Executes "task" for the indices 0 to "numTasks" - 1 and returns
+   * once all tasks are finished.
+   *
+   */
+  using Backend = std::function<void(
+      Eigen::Index numTasks, const std::function<void(Eigen::Index)> &task)>;
+
+  // MARK: public methods
+
+  /**
+   * @brief Set the number of threads of parallel loops. One thread runs all
+   * loops serially, zero selects the hardware concurrency.
+   *
+   * @param numThreads number of threads including the calling thread.
+   */
+  static void setNumThreads(int numThreads) {
+    assert(numThreads >= 0 && "Number of threads must be positive.");
+    std::lock_guard<std::mutex> lock{s_mutex};
+    s_numThreads = numThreads > 0 ? numThreads : getHardwareConcurrency();
+    // running loops keep their copy of the previous pool
+    s_pool.reset();
+  }
+
+  /**
+   * @brief Get the number of threads of parallel loops.
+   *
+   * @return int number of threads including the calling thread.
+   */
+  static int getNumThreads() {
+    std::lock_guard<std::mutex> lock{s_mutex};
+    return getNumThreadsLocked();
+  }
+
+  /**
+   * @brief Set the minimum number of work items per chunk. Loops with fewer
+   * than two chunks run serially.
+   *
+   * @param grainSize minimum number of work items per chunk.
+   */
+  static void setGrainSize(Eigen::Index grainSize) {
+    assert(grainSize > 0 && "Grain size must be positive.");
+    s_grainSize = grainSize;
+  }
+
+  /**
+   * @brief Get the minimum number of work items per chunk.
+   *
+   * @return Eigen::Index minimum number of work items per chunk.
+   */
+  static Eigen::Index getGrainSize() { return s_grainSize; }
+
+  /**
+   * @brief Set a "backend" executing the chunks of parallel loops instead of
+   * the internal thread pool, e.g. the executor of an application. An empty
+   * backend restores the default.
+   *
+   * @param backend executes the chunks of a loop.
+   */
+  static void setBackend(Backend backend) {
+    std::lock_guard<std::mutex> lock{s_mutex};
+    s_backend = std::move(backend);
+  }
+
+  /**
+   * @brief Determine if parallel loops are executed serially on the calling
+   * thread.
+   *
+   * @return true loops run serially.
+   * @return false loops may run in parallel.
+   */
+  static bool isSerial() { return s_inParallel || getNumThreads() <= 1; }
+
+  /**
+   * @brief Execute "task" on a background worker thread and return
+   * immediately. The task must not throw. The background queue is created on
+   * the first submission with Executor::getNumThreads worker threads. Tasks
+   * submitted by a background worker are executed on the calling thread
+   * before returning, such that tasks waiting for their subtasks cannot
+   * exhaust the workers.
+   *
+   * @param task task to execute.
+   */
+  static void submit(std::function<void()> task) {
+    if (s_inQueue) {
+      task();
+      return;
+    }
+
+    std::unique_lock<std::mutex> lock{s_mutex};
+    if (!s_queue)
+      s_queue = std::make_unique<TaskQueue>(getNumThreadsLocked());
+    TaskQueue &queue{*s_queue};
+    lock.unlock();
+    queue.push([task{std::move(task)}]() {
+      s_inQueue = true;
+      task();
+    });
+  }
+
+  /**
+   * @brief Execute "func" on the calling thread, such that the parallel loops
+   * of "func" throw OperationCancelled once a stop is requested for "token".
+   *
+   * @tparam Func type of the function.
+   * @param token token to observe.
+   * @param func function to execute.
+   * @return decltype(auto) result of "func".
+   */
+  template <typename Func>
+  static decltype(auto) withStopToken(std::stop_token token, Func &&func) {
+    const StopScope scope{std::move(token)};
+    return std::forward<Func>(func)();
+  }
+
+  /**
+   * @brief Determine if a stop was requested for the operation executed by the
+   * calling thread.
+   *
+   * @return true operation is cancelled.
+   * @return false operation continues.
+   */
+  static bool isCancelled() { return s_stopToken.stop_requested(); }
+
+  /**
+   * @brief Throw OperationCancelled if a stop was requested for the operation
+   * executed by the calling thread.
+   *
+   */
+  static void throwIfCancelled() {
+    if (isCancelled())
+      throw OperationCancelled{};
+  }
+
+  /**
+   * @brief Execute "func" for chunks of the index range ["begin", "end"). Each
+   * chunk is passed as its first and past-the-end index. Chunks contain at
+   * least "grainSize" indices and are executed concurrently, such that "func"
+   * must only write to disjoint data per chunk.
+   *
+   * @tparam Func type of the chunk function.
+   * @param begin first index.
+   * @param end past-the-end index.
+   * @param func function called with the limits of each chunk.
+   * @param grainSize minimum number of indices per chunk.
+   */
+  template <typename Func>
+  static void parallelFor(Eigen::Index begin, Eigen::Index end,
+                          const Func &func,
+                          Eigen::Index grainSize = getGrainSize()) {
+    const Eigen::Index size{end - begin};
+    if (size <= 0)
+      return;
+    throwIfCancelled();
+
+    grainSize = std::max<Eigen::Index>(grainSize, 1);
+    const int numThreads{s_inParallel ? 1 : getNumThreads()};
+    if (numThreads <= 1 || size < 2 * grainSize) {
+      func(begin, end);
+      return;
+    }
+
+    // several chunks per thread to balance uneven chunks
+    const Eigen::Index numChunks{
+        std::min<Eigen::Index>(size / grainSize, 4 * numThreads)};
+    // copy, since the calling thread reassigns its token in its chunks
+    const std::stop_token token{s_stopToken};
+    const std::function<void(Eigen::Index)> task{[&](Eigen::Index cChunk) {
+      const StopScope scope{token};
+      throwIfCancelled();
+      const bool inParallel{s_inParallel};
+      s_inParallel = true;
+      try {
+        func(begin + size * cChunk / numChunks,
+             begin + size * (cChunk + 1) / numChunks);
+      } catch (...) {
+        s_inParallel = inParallel;
+        throw;
+      }
+      s_inParallel = inParallel;
+    }};
+
+    run(numChunks, task, numThreads);
+  }
+
+private:
+  /**
+   * @brief Assigns a stop token to the calling thread for its lifetime and
+   * restores the previous token afterwards.
+   *
+   */
+  struct StopScope {
+    std::stop_token previous; /**<< token of the enclosing scope */
+
+    explicit StopScope(std::stop_token token)
+        : previous{std::exchange(s_stopToken, std::move(token))} {}
+    ~StopScope() { s_stopToken = std::move(previous); }
+  };
+
+  // MARK: private properties
+
+  static inline std::mutex s_mutex{};             /**<< guards the config */
+  static inline int s_numThreads{};               /**<< 0 until initialised */
+  static inline std::shared_ptr<ThreadPool> s_pool{}; /**<< internal pool */
+  static inline Backend s_backend{};               /**<< user backend */
+  static inline std::atomic<Eigen::Index> s_grainSize{
+      1024}; /**<< minimum number of work items per chunk */
+  static inline std::unique_ptr<TaskQueue> s_queue{}; /**<< background tasks */
+  static inline thread_local bool s_inParallel{
+      false}; /**<< thread executes a parallel loop */
+  static inline thread_local bool s_inQueue{
+      false}; /**<< thread is a background worker */
+  static inline thread_local std::stop_token
+      s_stopToken{}; /**<< token of the executed operation */
+
+  // MARK: private methods
+
+  /**
+   * @brief Get the number of hardware threads.
+   *
+   * @return int number of hardware threads, at least 1.
+   */
+  static int getHardwareConcurrency() {
+    return std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+  }
+
+  /**
+   * @brief Get the number of threads with locked configuration. Initialises
+   * the number from BASIS_SPLINES_NUM_THREADS or
+   * BASIS_SPLINES_DEFAULT_NUM_THREADS, where zero selects the hardware
+   * concurrency.
+   *
+   * @return int number of threads.
+   */
+  static int getNumThreadsLocked() {
+    if (s_numThreads == 0) {
+      const char *env{std::getenv("BASIS_SPLINES_NUM_THREADS")};
+      const int numThreads{env ? std::atoi(env)
+                               : BASIS_SPLINES_DEFAULT_NUM_THREADS};
+      s_numThreads = numThreads > 0 ? numThreads : getHardwareConcurrency();
+    }
+    return s_numThreads;
+  }
+
+  /**
+   * @brief Execute "numTasks" tasks with the backend, OpenMP or the internal
+   * pool.
+   *
+   * @param numTasks number of tasks.
+   * @param task task to execute for each index.
+   * @param numThreads number of threads.
+   */
+  static void run(Eigen::Index numTasks,
+                  const std::function<void(Eigen::Index)> &task,
+                  int numThreads) {
+    std::unique_lock<std::mutex> lock{s_mutex};
+    if (s_backend) {
+      const Backend backend{s_backend};
+      lock.unlock();
+      backend(numTasks, task);
+      return;
+    }
+
+#ifdef BASIS_SPLINES_OPENMP
+    lock.unlock();
+    std::exception_ptr error{};
+#pragma omp parallel for schedule(dynamic) num_threads(numThreads)
+    for (Eigen::Index cTask = 0; cTask < numTasks; ++cTask) {
+      try {
+        task(cTask);
+      } catch (...) {
+#pragma omp critical
+        if (!error)
+          error = std::current_exception();
+      }
+    }
+    if (error)
+      std::rethrow_exception(error);
+#else
+    if (!s_pool || s_pool->getNumWorkers() != numThreads - 1)
+      s_pool = std::make_shared<ThreadPool>(numThreads - 1);
+    // shared, since the pool might be replaced while running
+    const std::shared_ptr<ThreadPool> pool{s_pool};
+    lock.unlock();
+    pool->run(numTasks, task);
+#endif
+  }
+};
+}; // namespace BasisSplines
+
+#endif
@@ -0,0 +1,372 @@
+#ifndef HIERARCHICAL_BASIS_H
+#define HIERARCHICAL_BASIS_H
+
+#include <Eigen/Core>
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+#include <algorithm>
+#include <cassert>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "basisSplines/basis.h"
+#include "basisSplines/basisPool.h"
+#include "basisSplines/executor.h"
+#include "basisSplines/spline.h"
+
+namespace BasisSplines {
+
+/**
+ * @brief Truncated hierarchical B-spline (THB) basis for local refinement
+ * [GJS12].
+ *
+ * The hierarchy consists of levels of nested bases B^0, B^1, ..., where B^l+1
+ * results from inserting the midpoint of each knot span (cell) of B^l. Each
+ * level has a domain Ω^l, which is a union of level l cells with Ω^0 the
+ * whole domain and Ω^l+1 ⊆ Ω^l. Refining a cell of level l adds its two child
+ * cells to Ω^l+1.
+ *
+ * A function of level l is active if its support is contained in Ω^l but not
+ * in Ω^l+1. Active functions are truncated by removing the contributions of
+ * finer level functions with supports in the finer domains. The truncated
+ * functions are linearly independent and form a partition of unity. Each
+ * function is stored by its sparse coefficients in the finest basis, such that
+ * spline values are evaluated with the finest basis functions non-zero at a
+ * point and every hierarchical spline has an exact Spline representation.
+ *
+ * [GJS12] C. Giannelli, B. Jüttler, and H. Speleers, “THB-splines: The
+ * truncated basis for hierarchical splines,” Computer Aided Geometric Design,
+ * vol. 29, no. 7, pp. 485–498, Oct. 2012, doi: 10.1016/j.cagd.2012.03.025.
+ */
+class HierarchicalBasis {
+public:
+  // MARK: public methods
+
+  /**
+   * @brief Construct a new hierarchical basis with the level 0 "basis". Throws
+   * std::invalid_argument if the basis is not clamped.
+   *
+   * @param basis clamped basis of level 0.
+   */
+  explicit HierarchicalBasis(std::shared_ptr<Basis> basis) {
+    const Eigen::ArrayXd &knots{basis->knots()};
+    const int order{basis->order()};
+    if (knots(0) != knots(order - 1) ||
+        knots(knots.size() - 1) != knots(knots.size() - order))
+      throw std::invalid_argument("Basis must be clamped.");
+
+    m_bases.push_back(std::move(basis));
+    m_cells.push_back(getCells(*m_bases.back()));
+    m_domains.push_back(Mask::Constant(m_cells.back().size() - 1, true));
+    m_refined.push_back(Mask::Constant(m_cells.back().size() - 1, false));
+    update();
+  }
+
+  /**
+   * @brief Refine the cells of "level" in its domain that intersect the open
+   * interval ("begin", "end"). A new level is added if "level" is the finest
+   * one.
+   *
+   * @param level level of the cells to refine.
+   * @param begin first point of the refined interval.
+   * @param end last point of the refined interval.
+   */
+  void refine(int level, double begin, double end) {
+    if (level < 0 || level >= numLevels())
+      throw std::invalid_argument("Level must be in [0, numLevels()).");
+    if (!(begin < end))
+      throw std::invalid_argument("Refined interval must not be empty.");
+
+    if (level == numLevels() - 1)
+      addLevel();
+
+    const Eigen::ArrayXd &cells{m_cells[level]};
+    for (Eigen::Index cCell{}; cCell < cells.size() - 1; ++cCell)
+      if (m_domains[level](cCell) && cells(cCell) < end &&
+          cells(cCell + 1) > begin) {
+        m_refined[level](cCell) = true;
+        m_domains[level + 1].segment(2 * cCell, 2).setConstant(true);
+      }
+
+    update();
+  }
+
+  /**
+   * @brief Evaluate the active truncated functions at the given "points".
+   * Each point evaluates the finest basis functions non-zero on its span, see
+   * Basis::evalSpan, and accumulates their coefficients in the active
+   * functions.
+   *
+   * @param points evaluation points.
+   * @return Eigen::MatrixXd function values with "points.size()" rows and
+   * HierarchicalBasis::dim columns.
+   */
+  Eigen::MatrixXd operator()(const Eigen::ArrayXd &points) const {
+    const Basis &basis{*m_bases.back()};
+    const int order{basis.order()};
+    Eigen::MatrixXd values{Eigen::MatrixXd::Zero(points.size(), dim())};
+
+    Executor::parallelFor(
+        0, points.size(), [&](Eigen::Index begin, Eigen::Index end) {
+          Eigen::VectorXd basisValues(order);
+          for (Eigen::Index cPoint{begin}; cPoint < end; ++cPoint) {
+            const int span{basis.getSpan(points(cPoint))};
+            if (span < 0)
+              continue;
+            basis.evalSpan(points(cPoint), span, basisValues);
+            for (int cValue{}; cValue < order; ++cValue) {
+              const int idx{span - order + 1 + cValue};
+              if (idx < 0 || idx >= basis.dim())
+                continue;
+              for (Transform::InnerIterator entry{m_transform, idx}; entry;
+                   ++entry)
+                values(cPoint, entry.col()) +=
+                    basisValues(cValue) * entry.value();
+            }
+          }
+        });
+
+    return values;
+  }
+
+  /**
+   * @brief Determine coefficients that fit a hierarchical spline at the given
+   * "points" to the given "observations" in the least-squares sense.
+   *
+   * @tparam DecompositionType type of Eigen matrix decomposition
+   * @param observations values to fit the spline function.
+   * @param points evaluation points corresponding to the "observations".
+   * @return Eigen::MatrixXd coefficients of the active functions.
+   */
+  template <
+      typename DecompositionType = Eigen::ColPivHouseholderQR<Eigen::MatrixXd>>
+  Eigen::MatrixXd fit(const Eigen::MatrixXd &observations,
+                      const Eigen::VectorXd &points) const {
+    return DecompositionType{(*this)(points.array())}.solve(observations);
+  }
+
+  /**
+   * @brief Create the spline in the finest basis equal to the hierarchical
+   * spline with the given "coefficients".
+   *
+   * @param coefficients coefficients of the active functions.
+   * @return Spline spline equal to the hierarchical spline.
+   */
+  Spline toSpline(const Eigen::MatrixXd &coefficients) const {
+    assert(coefficients.rows() == dim() &&
+           "Coefficients must have same rows as basis dimensionality.");
+    return {m_bases.back(), Eigen::MatrixXd{m_transform * coefficients}};
+  }
+
+  /**
+   * @brief Determine the number of active functions.
+   *
+   * @return int basis dimensionality.
+   */
+  int dim() const { return static_cast<int>(m_transform.cols()); }
+
+  /**
+   * @brief Determine the basis order.
+   *
+   * @return int basis order.
+   */
+  int order() const { return m_bases.front()->order(); }
+
+  /**
+   * @brief Determine the number of levels.
+   *
+   * @return int number of levels.
+   */
+  int numLevels() const { return static_cast<int>(m_bases.size()); }
+
+  /**
+   * @brief Get the basis of the given "level".
+   *
+   * @param level basis level.
+   * @return std::shared_ptr<Basis> basis of "level".
+   */
+  std::shared_ptr<Basis> getBasis(int level) const { return m_bases[level]; }
+
+  /**
+   * @brief Get the indices of the active functions of "level" in its basis.
+   * The hierarchical functions are ordered by level and index.
+   *
+   * @param level basis level.
+   * @return const Eigen::ArrayXi& indices of the active functions.
+   */
+  const Eigen::ArrayXi &getActive(int level) const { return m_active[level]; }
+
+  /**
+   * @brief Get the coefficients of the active truncated functions in the
+   * finest basis.
+   *
+   * @return const Eigen::SparseMatrix<double, Eigen::RowMajor>& (finest dim x
+   * dim) sparse coefficients.
+   */
+  const Eigen::SparseMatrix<double, Eigen::RowMajor> &getTransform() const {
+    return m_transform;
+  }
+
+private:
+  using Mask = Eigen::Array<bool, Eigen::Dynamic, 1>;
+  using Transform = Eigen::SparseMatrix<double, Eigen::RowMajor>;
+
+  // MARK: private properties
+
+  std::vector<std::shared_ptr<Basis>> m_bases{}; /**<< basis per level */
+  std::vector<Eigen::SparseMatrix<double>>
+      m_refinements{}; /**<< coefficients of level l functions in level l+1 */
+  std::vector<Eigen::ArrayXd> m_cells{}; /**<< cell bounds per level */
+  std::vector<Mask> m_domains{};         /**<< cells in Ω^l per level */
+  std::vector<Mask> m_refined{};         /**<< cells in Ω^l+1 per level */
+  std::vector<Eigen::ArrayXi> m_active{}; /**<< active functions per level */
+  Transform m_transform{}; /**<< active functions in finest basis */
+
+  // MARK: private methods
+
+  /**
+   * @brief Determine the cell bounds as the distinct knots of the "basis".
+   *
+   * @param basis basis to determine the cells of.
+   * @return Eigen::ArrayXd ascending cell bounds.
+   */
+  static Eigen::ArrayXd getCells(const Basis &basis) {
+    std::vector<double> cells(basis.knots().begin(), basis.knots().end());
+    cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+    return Eigen::Map<const Eigen::ArrayXd>(cells.data(),
+                                            static_cast<Eigen::Index>(
+                                                cells.size()));
+  }
+
+  /**
+   * @brief Add a level by inserting the midpoints of the finest cells into the
+   * finest basis.
+   *
+   */
+  void addLevel() {
+    const Eigen::ArrayXd &cells{m_cells.back()};
+    const Eigen::Index numCells{cells.size() - 1};
+    const Eigen::ArrayXd midpoints{
+        0.5 * (cells.head(numCells) + cells.tail(numCells))};
+
+    // coefficients of the coarse functions in the refined basis by inserting
+    // the midpoints one after another [Boehm 1980], see
+    // Spline::interpolateCoefficients, where each insertion is a sparse map
+    const Basis &coarse{*m_bases.back()};
+    const int order{coarse.order()};
+    std::vector<double> knots(coarse.knots().begin(), coarse.knots().end());
+    Eigen::SparseMatrix<double> refinement(coarse.dim(), coarse.dim());
+    refinement.setIdentity();
+    for (const double midpoint : midpoints) {
+      const Eigen::Index dimOld{refinement.rows()};
+      std::vector<Eigen::Triplet<double>> entries{};
+      entries.reserve(2 * (dimOld + 1));
+      for (Eigen::Index cRow{}; cRow <= dimOld; ++cRow) {
+        // copy, interpolate, or shift coefficients
+        if (midpoint >= knots[cRow + order - 1])
+          entries.emplace_back(cRow, cRow, 1.0);
+        else if (knots[cRow] < midpoint) {
+          const double weight{(midpoint - knots[cRow]) /
+                              (knots[cRow + order - 1] - knots[cRow])};
+          entries.emplace_back(cRow, cRow - 1, 1.0 - weight);
+          entries.emplace_back(cRow, cRow, weight);
+        } else
+          entries.emplace_back(cRow, cRow - 1, 1.0);
+      }
+
+      Eigen::SparseMatrix<double> insertion(dimOld + 1, dimOld);
+      insertion.setFromTriplets(entries.begin(), entries.end());
+      refinement = insertion * refinement;
+      knots.insert(std::upper_bound(knots.begin(), knots.end(), midpoint),
+                   midpoint);
+    }
+
+    m_bases.push_back(BasisPool::makeBasis(coarse.insertKnots(midpoints)));
+    m_refinements.push_back(std::move(refinement));
+    m_cells.push_back(getCells(*m_bases.back()));
+    m_domains.push_back(Mask::Constant(2 * numCells, false));
+    m_refined.push_back(Mask::Constant(2 * numCells, false));
+  }
+
+  /**
+   * @brief Determine which functions of "level" have supports in the union of
+   * the given level "cells".
+   *
+   * @param level basis level.
+   * @param cells cells of the union.
+   * @return Mask functions with supports in the union.
+   */
+  Mask getSupported(int level, const Mask &cells) const {
+    const Basis &basis{*m_bases[level]};
+    const Eigen::ArrayXd &bounds{m_cells[level]};
+    const auto cellIdx{[&](double knot) {
+      return std::lower_bound(bounds.begin(), bounds.end(), knot) -
+             bounds.begin();
+    }};
+
+    Mask supported(basis.dim());
+    for (int cFunc{}; cFunc < basis.dim(); ++cFunc) {
+      const Eigen::Index first{cellIdx(basis.knots()(cFunc))};
+      const Eigen::Index last{cellIdx(basis.knots()(cFunc + basis.order()))};
+      supported(cFunc) = cells.segment(first, last - first).all();
+    }
+    return supported;
+  }
+
+  /**
+   * @brief Determine the active functions and their truncated coefficients in
+   * the finest basis.
+   *
+   */
+  void update() {
+    const int finest{numLevels() - 1};
+
+    // functions with supports in the domain of their level
+    std::vector<Mask> inDomain(numLevels());
+    for (int level{}; level <= finest; ++level)
+      inDomain[level] = getSupported(level, m_domains[level]);
+
+    m_active.resize(numLevels());
+    Eigen::Index numActive{};
+    for (int level{}; level <= finest; ++level) {
+      const Mask active{inDomain[level] &&
+                        !getSupported(level, m_refined[level])};
+      m_active[level].resize(active.count());
+      Eigen::Index cActive{};
+      for (Eigen::Index cFunc{}; cFunc < active.size(); ++cFunc)
+        if (active(cFunc))
+          m_active[level](cActive++) = static_cast<int>(cFunc);
+      numActive += cActive;
+    }
+
+    // refine active functions to the finest level and truncate the finer
+    // functions with supports in the finer domains
+    std::vector<Eigen::Triplet<double>> entries{};
+    Eigen::Index cCol{};
+    for (int level{}; level <= finest; ++level) {
+      Eigen::SparseMatrix<double> funcs(m_bases[level]->dim(),
+                                        m_active[level].size());
+      for (Eigen::Index cFunc{}; cFunc < funcs.cols(); ++cFunc)
+        funcs.insert(m_active[level](cFunc), cFunc) = 1.0;
+      for (int cLevel{level}; cLevel < finest; ++cLevel) {
+        funcs = m_refinements[cLevel] * funcs;
+        funcs.prune([&](Eigen::Index row, Eigen::Index, double) {
+          return !inDomain[cLevel + 1](row);
+        });
+      }
+      for (Eigen::Index cFunc{}; cFunc < funcs.outerSize(); ++cFunc)
+        for (Eigen::SparseMatrix<double>::InnerIterator entry{funcs, cFunc};
+             entry; ++entry)
+          entries.emplace_back(entry.row(), cCol + cFunc, entry.value());
+      cCol += funcs.cols();
+    }
+
+    m_transform.resize(m_bases.back()->dim(), numActive);
+    m_transform.setFromTriplets(entries.begin(), entries.end());
+  }
+};
+}; // namespace BasisSplines
+
+#endif
@@ -24,7 +24,7 @@ public:
    *
    * @param basis spline basis.
    */
-  Interpolate(const std::shared_ptr<Basis> basis) : m_basis{basis} {};
+  Interpolate(std::shared_ptr<Basis> basis) : m_basis{std::move(basis)} {};
 
   /**
    * @brief Determine coefficients that fit a spline function at the given
@@ -114,5 +114,24 @@ private:
 
   std::shared_ptr<Basis> m_basis; /**<< spline basis */
 };
+
+#ifdef BASIS_SPLINES_COMPILED
+// instantiated in the compiled library, see src/basisSplines.cpp
+extern template std::pair<Eigen::MatrixXd, Eigen::MatrixXd>
+Basis::add<Interpolate>(const Basis &, Basis &, double, double) const;
+extern template Eigen::MatrixXd
+Basis::prod<Interpolate>(const Basis &, Basis &, double, double) const;
+extern template Eigen::MatrixXd
+Interpolate::fit<Eigen::ColPivHouseholderQR<Eigen::MatrixXd>>(
+    const Eigen::MatrixXd &, const Eigen::VectorXd &) const;
+extern template Eigen::MatrixXd
+Interpolate::fit<Eigen::ColPivHouseholderQR<Eigen::MatrixXd>>(
+    const std::vector<Eigen::MatrixXd> &, const std::vector<Eigen::VectorXi> &,
+    const Eigen::ArrayXd &) const;
+#endif
 }; // namespace BasisSplines
+
+#ifdef BASIS_SPLINES_COMPILED
+extern template class Eigen::ColPivHouseholderQR<Eigen::MatrixXd>;
+#endif
 #endif
\ No newline at end of file
@@ -2,6 +2,12 @@
 #define MATH_H
 
 #include <Eigen/Core>
+#include <cassert>
+#include <cmath>
+#include <numbers>
+#include <utility>
+
+#include "basisSplines/cpuDispatch.h"
 
 namespace BasisSplines {
 /**
@@ -13,8 +19,8 @@ namespace BasisSplines {
  * @param matR right operand matrix (n x mR).
  * @return Eigen::MatrixXd result matrix (n x mL*mR).
  */
-Eigen::MatrixXd khatriRao(const Eigen::MatrixXd &matL,
-                          const Eigen::MatrixXd &matR) {
+inline Eigen::MatrixXd khatriRao(const Eigen::MatrixXd &matL,
+                                 const Eigen::MatrixXd &matR) {
   // test equality or row numbers
   assert(matL.rows() == matR.rows() &&
          "Number of rows in left and right arrays must be equal.");
@@ -22,18 +28,13 @@ Eigen::MatrixXd khatriRao(const Eigen::MatrixXd &matL,
   // initialize result matrix
   Eigen::MatrixXd matRes(matL.rows(), matL.cols() * matR.cols());
 
-  // fill result matrix row-wise
-  int cRow{};
-  for (const auto rowArrL : matL.rowwise()) {
-    // product of each matL row element with current row of matR
-    int cCol{};
-    for (const double coeffL : rowArrL) {
-      matRes(cRow, Eigen::seqN(cCol, matR.cols())) =
-          coeffL * matR(cRow, Eigen::all);
-      cCol += matR.cols();
-    }
-    ++cRow;
-  }
+  // each result column is the element-wise product of a matL and a matR
+  // column, computed by the kernel of the active instruction set level
+  for (Eigen::Index cColL{}; cColL < matL.cols(); ++cColL)
+    for (Eigen::Index cColR{}; cColR < matR.cols(); ++cColR)
+      CpuDispatch::mul(matL.col(cColL).data(), matR.col(cColR).data(),
+                       matRes.col(cColL * matR.cols() + cColR).data(),
+                       matL.rows());
 
   return matRes;
 }
@@ -45,7 +46,8 @@ Eigen::MatrixXd khatriRao(const Eigen::MatrixXd &matL,
  * @param matR right operand matrix (nL x mR).
  * @return Eigen::MatrixXd result matrix (nL*nR x mL*mR).
  */
-Eigen::MatrixXd kron(const Eigen::MatrixXd &matL, const Eigen::MatrixXd &matR) {
+inline Eigen::MatrixXd kron(const Eigen::MatrixXd &matL,
+                            const Eigen::MatrixXd &matR) {
   // initialize result matrix
   Eigen::MatrixXd matRes(matL.rows() * matR.rows(), matL.cols() * matR.cols());
 
@@ -64,5 +66,106 @@ Eigen::MatrixXd kron(const Eigen::MatrixXd &matL, const Eigen::MatrixXd &matR) {
 
   return matRes;
 }
+
+/**
+ * @brief Evaluate a Bezier curve given by its "controlPoints" at the local
+ * parameter "param" in [0, 1] with the de Casteljau algorithm.
+ *
+ * @param controlPoints control points (degree + 1 x output dimensionality).
+ * @param param local curve parameter.
+ * @return Eigen::VectorXd curve value at "param".
+ */
+inline Eigen::VectorXd deCasteljau(const Eigen::MatrixXd &controlPoints,
+                                   double param) {
+  Eigen::MatrixXd points{controlPoints};
+
+  // convex combination of neighboring points until a single point remains
+  for (Eigen::Index level{1}; level < points.rows(); ++level)
+    for (Eigen::Index cRow{}; cRow < points.rows() - level; ++cRow)
+      points.row(cRow) =
+          (1.0 - param) * points.row(cRow) + param * points.row(cRow + 1);
+
+  return points.row(0).transpose();
+}
+
+/**
+ * @brief Split a Bezier curve given by its "controlPoints" at the local
+ * parameter "param" in [0, 1] with the de Casteljau algorithm.
+ *
+ * @param controlPoints control points (degree + 1 x output dimensionality).
+ * @param param local curve parameter at which the curve is split.
+ * @return std::pair<Eigen::MatrixXd, Eigen::MatrixXd> control points of the
+ * left and the right part.
+ */
+inline std::pair<Eigen::MatrixXd, Eigen::MatrixXd>
+deCasteljauSplit(const Eigen::MatrixXd &controlPoints, double param) {
+  Eigen::MatrixXd points{controlPoints};
+  Eigen::MatrixXd pointsL(controlPoints.rows(), controlPoints.cols());
+  Eigen::MatrixXd pointsR(controlPoints.rows(), controlPoints.cols());
+
+  // the first and last points of each de Casteljau level form the left and
+  // right control points
+  const Eigen::Index degree{controlPoints.rows() - 1};
+  pointsL.row(0) = points.row(0);
+  pointsR.row(degree) = points.row(degree);
+  for (Eigen::Index level{1}; level <= degree; ++level) {
+    for (Eigen::Index cRow{}; cRow <= degree - level; ++cRow)
+      points.row(cRow) =
+          (1.0 - param) * points.row(cRow) + param * points.row(cRow + 1);
+    pointsL.row(level) = points.row(0);
+    pointsR.row(degree - level) = points.row(degree - level);
+  }
+
+  return {pointsL, pointsR};
+}
+
+/**
+ * @brief Determine the nodes and weights of the Gauss-Legendre quadrature with
+ * "numNodes" nodes on [-1, 1]. The quadrature integrates polynomials up to
+ * degree 2 * "numNodes" - 1 exactly. The nodes are the roots of the Legendre
+ * polynomial found by Newton's method from Chebyshev estimates.
+ *
+ * @param numNodes number of quadrature nodes.
+ * @return std::pair<Eigen::ArrayXd, Eigen::ArrayXd> nodes in ascending order
+ * and weights.
+ */
+inline std::pair<Eigen::ArrayXd, Eigen::ArrayXd> gaussLegendre(int numNodes) {
+  assert(numNodes > 0 && "Number of nodes must be positive.");
+  Eigen::ArrayXd nodes(numNodes);
+  Eigen::ArrayXd weights(numNodes);
+
+  // nodes are symmetric, determine the positive ones
+  for (int cNode{}; cNode < (numNodes + 1) / 2; ++cNode) {
+    double node{
+        std::cos(std::numbers::pi * (cNode + 0.75) / (numNodes + 0.5))};
+    double derivative{};
+    for (int cIter{}; cIter < 100; ++cIter) {
+      // Legendre polynomial and its derivative by three-term recurrence
+      double valueCurr{1.0};
+      double valuePrev{};
+      for (int cDeg{1}; cDeg <= numNodes; ++cDeg) {
+        const double valueNext{
+            ((2.0 * cDeg - 1.0) * node * valueCurr - (cDeg - 1.0) * valuePrev) /
+            cDeg};
+        valuePrev = valueCurr;
+        valueCurr = valueNext;
+      }
+      derivative =
+          numNodes * (node * valueCurr - valuePrev) / (node * node - 1.0);
+
+      const double step{valueCurr / derivative};
+      node -= step;
+      if (std::abs(step) < 1e-15)
+        break;
+    }
+
+    nodes(cNode) = -node;
+    nodes(numNodes - 1 - cNode) = node;
+    weights(cNode) = 2.0 / ((1.0 - node * node) * derivative * derivative);
+    weights(numNodes - 1 - cNode) = weights(cNode);
+  }
+
+  return {nodes, weights};
+}
 }; // namespace BasisSplines
 #endif
\ No newline at end of file
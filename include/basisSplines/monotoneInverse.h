@@ -0,0 +1,247 @@
+#ifndef MONOTONE_INVERSE_H
+#define MONOTONE_INVERSE_H
+
+#include <Eigen/Core>
+#include <algorithm>
+#include <stdexcept>
+
+#include "basisSplines/spline.h"
+
+namespace BasisSplines {
+
+/**
+ * @brief Inverse of a monotone spline along one output dimension.
+ *
+ * Each query value is assigned to a polynomial piece by a binary search on the
+ * values at the piece ends. The point within the piece is determined by Newton
+ * iterations safeguarded by the Illinois variant of the regula falsi.
+ * The pieces are stored in power form for evaluation with the Horner scheme.
+ */
+class MonotoneInverse {
+public:
+  // MARK: public methods
+
+  /**
+   * @brief Construct the inverse of the given "spline" along the output
+   * dimension "dim".
+   *
+   * The spline is monotone if its coefficients are monotone [Boo01, Ch. IX].
+   * Throws std::invalid_argument if the coefficients are neither
+   * non-decreasing nor non-increasing.
+   *
+   * @param spline monotone spline.
+   * @param dim output dimension to invert.
+   * @param accMono tolerated violation of coefficient monotonicity.
+   */
+  MonotoneInverse(const Spline &spline, int dim = 0, double accMono = 0.0) {
+    const Eigen::ArrayXd coeffs{spline.getCoefficients().col(dim)};
+    const Eigen::ArrayXd diffs{coeffs.tail(coeffs.size() - 1) -
+                               coeffs.head(coeffs.size() - 1)};
+
+    // monotonicity of coefficients is sufficient for spline monotonicity
+    if ((diffs >= -accMono).all())
+      m_sign = 1.0;
+    else if ((diffs <= accMono).all())
+      m_sign = -1.0;
+    else
+      throw std::invalid_argument("Spline coefficients are not monotone.");
+
+    // count non-empty spans in the spline domain
+    const Eigen::ArrayXd &knots{spline.basis()->knots()};
+    const int order{spline.basis()->order()};
+    int numSpans{};
+    for (int span{order - 1}; span < spline.basis()->dim(); ++span)
+      numSpans += knots(span) < knots(span + 1);
+
+    m_begins.resize(numSpans);
+    m_ends.resize(numSpans);
+    m_valuesBegin.resize(numSpans);
+    m_valuesEnd.resize(numSpans);
+    m_polys.resize(numSpans, order);
+
+    // store each piece in power form of the local parameter in [0, 1]
+    int cSpan{};
+    for (int span{order - 1}; span < spline.basis()->dim(); ++span) {
+      if (knots(span) >= knots(span + 1))
+        continue;
+
+      Eigen::ArrayXd diffTable{m_sign * spline.getBezier(span).col(dim).array()};
+      m_begins(cSpan) = knots(span);
+      m_ends(cSpan) = knots(span + 1);
+      m_valuesBegin(cSpan) = diffTable(0);
+      m_valuesEnd(cSpan) = diffTable(order - 1);
+
+      // power coefficients a_j = binom(degree, j) * diff^j(controlPoints)_0
+      double binom{1.0};
+      for (int level{}; level < order; ++level) {
+        m_polys(cSpan, level) = binom * diffTable(0);
+        for (int cRow{}; cRow < order - 1 - level; ++cRow)
+          diffTable(cRow) = diffTable(cRow + 1) - diffTable(cRow);
+        binom = binom * (order - 1 - level) / (level + 1);
+      }
+      ++cSpan;
+    }
+  }
+
+  /**
+   * @brief Determine the point at which the spline takes the given "value".
+   * Values outside the spline range are mapped to the domain ends.
+   *
+   * @param value spline value to invert.
+   * @param maxIter maximum number of iterations.
+   * @param accAbs tolerance for the spline value.
+   * @return double point with spline value "value".
+   */
+  double operator()(double value, int maxIter = 32,
+                    double accAbs = 1e-12) const {
+    value *= m_sign;
+
+    // first piece whose end value is not less than the query
+    const int span{static_cast<int>(
+        std::lower_bound(m_valuesEnd.begin(), m_valuesEnd.end(), value) -
+        m_valuesEnd.begin())};
+
+    return solve(std::min(span, static_cast<int>(m_ends.size()) - 1), value,
+                 maxIter, accAbs);
+  }
+
+  /**
+   * @brief Determine the points at which the spline takes the given "values".
+   * For "sorted" values with the same order as the spline values, the pieces
+   * are found by a single sweep instead of a binary search per value.
+   *
+   * @param values spline values to invert.
+   * @param sorted values are sorted along the spline monotonicity.
+   * @param maxIter maximum number of iterations.
+   * @param accAbs tolerance for the spline value.
+   * @return Eigen::ArrayXd points with spline values "values".
+   */
+  Eigen::ArrayXd operator()(const Eigen::ArrayXd &values, bool sorted = false,
+                            int maxIter = 32, double accAbs = 1e-12) const {
+    Eigen::ArrayXd points(values.size());
+
+    if (!sorted) {
+      for (int cValue{}; cValue < values.size(); ++cValue)
+        points(cValue) = (*this)(values(cValue), maxIter, accAbs);
+      return points;
+    }
+
+    // sweep over pieces while processing the sorted values
+    int span{};
+    const int lastSpan{static_cast<int>(m_ends.size()) - 1};
+    for (int cValue{}; cValue < values.size(); ++cValue) {
+      const double value{m_sign * values(cValue)};
+      while (span < lastSpan && m_valuesEnd(span) < value)
+        ++span;
+      points(cValue) = solve(span, value, maxIter, accAbs);
+    }
+
+    return points;
+  }
+
+  /**
+   * @brief Get the first point of the inverse range.
+   *
+   * @return double first point of the spline domain.
+   */
+  double begin() const { return m_begins(0); }
+
+  /**
+   * @brief Get the last point of the inverse range.
+   *
+   * @return double last point of the spline domain.
+   */
+  double end() const { return m_ends(m_ends.size() - 1); }
+
+private:
+  // MARK: private properties
+
+  Eigen::ArrayXd m_begins;      /**<< first points of pieces */
+  Eigen::ArrayXd m_ends;        /**<< last points of pieces */
+  Eigen::ArrayXd m_valuesBegin; /**<< oriented values at first points */
+  Eigen::ArrayXd m_valuesEnd;   /**<< oriented values at last points */
+  Eigen::ArrayXXd m_polys;      /**<< power coefficients of pieces */
+  double m_sign{1.0}; /**<< 1.0 for increasing, -1.0 for decreasing spline */
+
+  // MARK: private methods
+
+  /**
+   * @brief Evaluate the piece "span" and its derivative with respect to the
+   * local parameter at "param".
+   *
+   * @param span piece index.
+   * @param param local parameter in [0, 1].
+   * @return std::pair<double, double> piece value and derivative.
+   */
+  std::pair<double, double> evalPiece(int span, double param) const {
+    double value{m_polys(span, m_polys.cols() - 1)};
+    double deriv{};
+    for (Eigen::Index cCoeff{m_polys.cols() - 2}; cCoeff >= 0; --cCoeff) {
+      deriv = deriv * param + value;
+      value = value * param + m_polys(span, cCoeff);
+    }
+    return {value, deriv};
+  }
+
+  /**
+   * @brief Solve for the point in piece "span" at which the oriented spline
+   * takes "value". Newton steps leaving the bracket of the root are replaced by
+   * Illinois steps.
+   *
+   * @param span piece index.
+   * @param value oriented spline value.
+   * @param maxIter maximum number of iterations.
+   * @param accAbs tolerance for the spline value.
+   * @return double point with spline value "value".
+   */
+  double solve(int span, double value, int maxIter, double accAbs) const {
+    const double length{m_ends(span) - m_begins(span)};
+
+    // values outside the piece range, e.g. at jumps or beyond the domain
+    if (value <= m_valuesBegin(span))
+      return m_begins(span);
+    if (value >= m_valuesEnd(span))
+      return m_ends(span);
+
+    // bracket [paramL, paramR] with residuals of opposite sign
+    double paramL{}, paramR{1.0};
+    double resL{m_valuesBegin(span) - value};
+    double resR{m_valuesEnd(span) - value};
+    int sideLast{};
+
+    // initial guess by linear interpolation
+    double param{resL / (resL - resR)};
+    for (int iter{}; iter < maxIter; ++iter) {
+      const auto [res, deriv] = evalPiece(span, param);
+      const double residual{res - value};
+      if (std::abs(residual) <= accAbs)
+        break;
+
+      // update bracket and apply Illinois modification to stagnating side
+      if (residual < 0.0) {
+        paramL = param;
+        resL = residual;
+        if (sideLast == -1)
+          resR *= 0.5;
+        sideLast = -1;
+      } else {
+        paramR = param;
+        resR = residual;
+        if (sideLast == 1)
+          resL *= 0.5;
+        sideLast = 1;
+      }
+
+      // Newton step if in bracket, otherwise regula falsi step
+      const double paramNewton{param - residual / deriv};
+      param = deriv > 0.0 && paramNewton > paramL && paramNewton < paramR
+                  ? paramNewton
+                  : (paramL * resR - paramR * resL) / (resR - resL);
+    }
+
+    return m_begins(span) + param * length;
+  }
+};
+}; // namespace BasisSplines
+
+#endif
@@ -0,0 +1,202 @@
+#ifndef PROJECT_H
+#define PROJECT_H
+
+#include <Eigen/Core>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "basisSplines/basis.h"
+#include "basisSplines/math.h"
+
+namespace BasisSplines {
+
+/**
+ * @brief Determines the spline coefficients for a basis as L2 projection of a
+ * process.
+ *
+ * The coefficients c minimise the integral of the squared difference between
+ * the spline and the process over the knot range. They solve M c = b with
+ * the mass matrix M_ij = ∫ b_i b_j and the moments b_i = ∫ b_i f. The
+ * integrals are computed by Gauss-Legendre quadrature on each non-empty knot
+ * span and the process is called once with the quadrature points of all
+ * spans. Since each point lies in the support of "order" basis functions, M
+ * is banded and its Cholesky factor is computed in band storage once per
+ * basis.
+ *
+ * Unlike Interpolate, which matches the process at the Greville sites, the
+ * projection averages the process over each span and does not alias
+ * oscillations between the sites. Project can be used as interpolation type,
+ * e.g. Spline::add<Project>.
+ */
+class Project {
+public:
+  // MARK: public methods
+
+  /**
+   * @brief Construct a new Project for the given Basis. The mass matrix is
+   * assembled and factorised on construction.
+   *
+   * @param basis spline basis.
+   * @param numNodes number of quadrature nodes per knot span, 0 selects the
+   * basis order which integrates the mass matrix exactly.
+   */
+  Project(std::shared_ptr<Basis> basis, int numNodes = 0)
+      : m_basis{std::move(basis)} {
+    assert(numNodes >= 0 && "Number of nodes must be positive.");
+    const int order{m_basis->order()};
+    const auto [nodes, weights] =
+        gaussLegendre(numNodes > 0 ? numNodes : order);
+    const Eigen::ArrayXd &knots{m_basis->knots()};
+
+    // quadrature points are placed on non-empty knot spans
+    std::vector<int> spans{};
+    for (int span{}; span < knots.size() - 1; ++span)
+      if (knots(span) < knots(span + 1))
+        spans.push_back(span);
+
+    const Eigen::Index numPoints{static_cast<Eigen::Index>(spans.size()) *
+                                 nodes.size()};
+    m_points.resize(numPoints);
+    m_weights.resize(numPoints);
+    m_firsts.resize(numPoints);
+    m_values.resize(order, numPoints);
+
+    Eigen::Index cPoint{};
+    for (const int span : spans) {
+      const double center{0.5 * (knots(span) + knots(span + 1))};
+      const double halfWidth{0.5 * (knots(span + 1) - knots(span))};
+      for (Eigen::Index cNode{}; cNode < nodes.size(); ++cNode, ++cPoint) {
+        m_points(cPoint) = center + halfWidth * nodes(cNode);
+        m_weights(cPoint) = halfWidth * weights(cNode);
+        m_firsts(cPoint) = span - order + 1;
+        m_basis->evalSpan(m_points(cPoint), span, m_values.col(cPoint));
+      }
+    }
+
+    factorise();
+  }
+
+  /**
+   * @brief Determine coefficients of the L2 projection of the given process.
+   * The process is called once with all quadrature points.
+   *
+   * @param process function representation of the process.
+   * @return Eigen::MatrixXd spline coefficients approximating the process.
+   */
+  Eigen::MatrixXd
+  fit(std::function<Eigen::MatrixXd(Eigen::VectorXd)> process) const {
+    const Eigen::MatrixXd values{process(m_points.matrix())};
+    assert(values.rows() == m_points.size() &&
+           "Process must return one row per point.");
+
+    // moments of the process per basis function with coefficients along
+    // columns for contiguous updates
+    const Eigen::MatrixXd valuesT{values.transpose()};
+    Eigen::MatrixXd coeffsT{Eigen::MatrixXd::Zero(values.cols(), dim())};
+    for (Eigen::Index cPoint{}; cPoint < m_points.size(); ++cPoint)
+      for (int cValue{}; cValue < order(); ++cValue) {
+        const int idx{m_firsts(cPoint) + cValue};
+        if (idx >= 0 && idx < dim())
+          coeffsT.col(idx) += m_weights(cPoint) * m_values(cValue, cPoint) *
+                              valuesT.col(cPoint);
+      }
+
+    // solve L y = b and L^T c = y with the band Cholesky factor L
+    const int bandwidth{order() - 1};
+    for (int col{}; col < dim(); ++col) {
+      coeffsT.col(col) /= m_factor(0, col);
+      for (int row{col + 1}; row <= std::min(dim() - 1, col + bandwidth);
+           ++row)
+        coeffsT.col(row) -= m_factor(row - col, col) * coeffsT.col(col);
+    }
+    for (int col{dim() - 1}; col >= 0; --col) {
+      for (int row{col + 1}; row <= std::min(dim() - 1, col + bandwidth);
+           ++row)
+        coeffsT.col(col) -= m_factor(row - col, col) * coeffsT.col(row);
+      coeffsT.col(col) /= m_factor(0, col);
+    }
+
+    return coeffsT.transpose();
+  }
+
+  /**
+   * @brief Get the quadrature points at which the process is evaluated.
+   *
+   * @return const Eigen::ArrayXd& quadrature points in ascending order.
+   */
+  const Eigen::ArrayXd &getPoints() const { return m_points; }
+
+private:
+  // MARK: private properties
+
+  std::shared_ptr<Basis> m_basis; /**<< spline basis */
+  Eigen::ArrayXd m_points{};      /**<< quadrature points of all spans */
+  Eigen::ArrayXd m_weights{};     /**<< quadrature weights of all spans */
+  Eigen::ArrayXi m_firsts{};      /**<< first non-zero function per point */
+  Eigen::MatrixXd m_values{};     /**<< (order x points) non-zero values */
+  Eigen::MatrixXd m_factor{}; /**<< (order x dim) band of Cholesky factor */
+
+  // MARK: private methods
+
+  /**
+   * @brief Determine basis dimensionality.
+   *
+   * @return int basis dimensionality.
+   */
+  int dim() const { return m_basis->dim(); }
+
+  /**
+   * @brief Determine basis order.
+   *
+   * @return int basis order.
+   */
+  int order() const { return m_basis->order(); }
+
+  /**
+   * @brief Assemble the mass matrix in lower band storage with m_factor(i - j,
+   * j) = M_ij and factorise it in place by Cholesky decomposition.
+   *
+   */
+  void factorise() {
+    m_factor = Eigen::MatrixXd::Zero(order(), dim());
+    for (Eigen::Index cPoint{}; cPoint < m_points.size(); ++cPoint)
+      for (int cRow{}; cRow < order(); ++cRow) {
+        const int row{m_firsts(cPoint) + cRow};
+        if (row < 0 || row >= dim())
+          continue;
+        for (int cCol{}; cCol <= cRow; ++cCol) {
+          const int col{m_firsts(cPoint) + cCol};
+          if (col >= 0)
+            m_factor(row - col, col) += m_weights(cPoint) *
+                                        m_values(cRow, cPoint) *
+                                        m_values(cCol, cPoint);
+        }
+      }
+
+    const int bandwidth{order() - 1};
+    for (int col{}; col < dim(); ++col) {
+      double pivot{m_factor(0, col)};
+      for (int cPrev{std::max(0, col - bandwidth)}; cPrev < col; ++cPrev)
+        pivot -= m_factor(col - cPrev, cPrev) * m_factor(col - cPrev, cPrev);
+      if (!(pivot > 0.0))
+        throw std::invalid_argument("Mass matrix is not positive definite.");
+      m_factor(0, col) = std::sqrt(pivot);
+
+      for (int row{col + 1}; row <= std::min(dim() - 1, col + bandwidth);
+           ++row) {
+        double value{m_factor(row - col, col)};
+        for (int cPrev{std::max(0, row - bandwidth)}; cPrev < col; ++cPrev)
+          value -= m_factor(row - cPrev, cPrev) * m_factor(col - cPrev, cPrev);
+        m_factor(row - col, col) = value / m_factor(0, col);
+      }
+    }
+  }
+};
+}; // namespace BasisSplines
+
+#endif
@@ -0,0 +1,255 @@
+#ifndef QUANTISED_SPLINE_H
+#define QUANTISED_SPLINE_H
+
+#include <Eigen/Core>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+#include "basisSplines/basis.h"
+#include "basisSplines/basisPool.h"
+#include "basisSplines/spline.h"
+#include "basisSplines/splineWorkspace.h"
+
+namespace BasisSplines {
+
+/**
+ * @brief Polynomial spline with quantised coefficients and knots.
+ *
+ * The coefficients of each output dimension are stored as 16 bit integers q
+ * with a scale s and an offset o such that the coefficient is c = o + s q.
+ * The knots are stored as the first knot and the offsets of all knots to the
+ * first knot in 32 bit fixed point.
+ *
+ * The spline is evaluated on its domain ["knots(order - 1)", "knots(dim)"] by
+ * the de Boor algorithm [Boo01, Ch. X] on the dequantised coefficients of the
+ * evaluation span.
+ */
+class QuantisedSpline {
+public:
+  // MARK: public methods
+  QuantisedSpline() = default;
+
+  /**
+   * @brief Construct a quantised representation of the "spline".
+   *
+   * The coefficient quantisation error is at most half the scale of each
+   * output dimension. Since the basis is a partition of unity on the spline
+   * domain, this bounds the spline error due to coefficients. The error due to
+   * the knot rounding is determined on "numSamples" points per span. The
+   * maximum of both is reported by QuantisedSpline::getMaxError.
+   *
+   * @param spline spline to quantise.
+   * @param numSamples number of points per span to determine the error.
+   */
+  QuantisedSpline(const Spline &spline, int numSamples = 8)
+      : m_basisScale{spline.basis()->getScale()},
+        m_order{spline.basis()->order()}, m_numCoeffs{spline.basis()->dim()},
+        m_dim{spline.dim()} {
+    // knots as fixed point offsets to the first knot
+    const Eigen::ArrayXd &knots{spline.basis()->knots()};
+    constexpr double levelsKnots{std::numeric_limits<uint32_t>::max()};
+    m_knotFirst = knots(0);
+    m_knotStep = (knots(knots.size() - 1) - m_knotFirst) / levelsKnots;
+    m_knotOffsets.resize(knots.size());
+    for (Eigen::Index cKnot{}; cKnot < knots.size(); ++cKnot)
+      m_knotOffsets[cKnot] =
+          m_knotStep > 0.0 ? static_cast<uint32_t>(std::min(
+                                 std::round((knots(cKnot) - m_knotFirst) /
+                                            m_knotStep),
+                                 levelsKnots))
+                           : 0;
+
+    // non-empty spans of the spline domain
+    m_spanFirst = m_order - 1;
+    while (m_spanFirst < m_numCoeffs - 1 &&
+           m_knotOffsets[m_spanFirst] >= m_knotOffsets[m_spanFirst + 1])
+      ++m_spanFirst;
+    m_spanLast = m_numCoeffs - 1;
+    while (m_spanLast > m_spanFirst &&
+           m_knotOffsets[m_spanLast] >= m_knotOffsets[m_spanLast + 1])
+      --m_spanLast;
+
+    // coefficients symmetrically quantised around the column center
+    constexpr double levels{std::numeric_limits<int16_t>::max()};
+    const Eigen::MatrixXd &coeffs{spline.getCoefficients()};
+    m_scales.resize(m_dim);
+    m_offsets.resize(m_dim);
+    m_coefficients.resize(static_cast<size_t>(m_numCoeffs) * m_dim);
+    double errorCoeffs{};
+    for (int cDim{}; cDim < m_dim; ++cDim) {
+      const double max{coeffs.col(cDim).maxCoeff()};
+      const double min{coeffs.col(cDim).minCoeff()};
+      m_offsets(cDim) = 0.5 * (max + min);
+      m_scales(cDim) = 0.5 * (max - min) / levels;
+      errorCoeffs = std::max(errorCoeffs, 0.5 * m_scales(cDim));
+
+      for (int cCoeff{}; cCoeff < m_numCoeffs; ++cCoeff)
+        m_coefficients[static_cast<size_t>(cDim) * m_numCoeffs + cCoeff] =
+            m_scales(cDim) > 0.0
+                ? static_cast<int16_t>(std::clamp(
+                      std::round((coeffs(cCoeff, cDim) - m_offsets(cDim)) /
+                                 m_scales(cDim)),
+                      -levels, levels))
+                : 0;
+    }
+
+    // sampled error due to coefficients and knots
+    Eigen::ArrayXd points(numSamples * (m_spanLast - m_spanFirst + 1) + 1);
+    Eigen::Index cPoint{};
+    for (int span{m_spanFirst}; span <= m_spanLast; ++span)
+      for (int cSample{}; cSample < numSamples; ++cSample)
+        points(cPoint++) = knots(span) + (knots(span + 1) - knots(span)) *
+                                             cSample / numSamples;
+    points(cPoint++) = knots(m_spanLast + 1);
+    const double errorSampled{
+        (spline(points.head(cPoint)) - (*this)(points.head(cPoint)))
+            .abs()
+            .maxCoeff()};
+    m_maxError = std::max(errorCoeffs, errorSampled);
+  }
+
+  /**
+   * @brief Evaluate the quantised spline at given "points".
+   * Points more than "accSegment" outside the spline domain evaluate to zero.
+   *
+   * @param points evaluation points.
+   * @param accSegment accuracy for assigning points outside the domain.
+   * @return Eigen::ArrayXXd spline values with "points.size()" rows and
+   * "dim()" columns.
+   */
+  Eigen::ArrayXXd operator()(const Eigen::ArrayXd &points,
+                             double accSegment = 1e-6) const {
+    Eigen::ArrayXXd values{Eigen::ArrayXXd::Zero(points.size(), m_dim)};
+    std::pmr::memory_resource *resource{SplineWorkspace::resource()};
+    std::pmr::vector<double> knots(2 * m_order - 2, resource);
+    std::pmr::vector<double> table(m_order, resource);
+
+    for (Eigen::Index cPoint{}; cPoint < points.size(); ++cPoint) {
+      const double offset{points(cPoint) - m_knotFirst};
+      if (offset < getKnot(m_spanFirst) - accSegment ||
+          offset > getKnot(m_spanLast + 1) + accSegment)
+        continue;
+
+      // right closed span containing the point
+      const int knotIdx{static_cast<int>(
+          std::lower_bound(m_knotOffsets.begin(), m_knotOffsets.end(), offset,
+                           [this](uint32_t knot, double value) {
+                             return knot * m_knotStep < value;
+                           }) -
+          m_knotOffsets.begin())};
+      const int span{std::clamp(knotIdx - 1, m_spanFirst, m_spanLast)};
+
+      // decode knots "knots(span - order + 2)" to "knots(span + order - 1)"
+      for (int cKnot{}; cKnot < 2 * m_order - 2; ++cKnot)
+        knots[cKnot] = getKnot(span - m_order + 2 + cKnot);
+
+      for (int cDim{}; cDim < m_dim; ++cDim) {
+        // dequantise coefficients of the span
+        const int16_t *coeffs{
+            &m_coefficients[static_cast<size_t>(cDim) * m_numCoeffs + span -
+                            m_order + 1]};
+        for (int cCoeff{}; cCoeff < m_order; ++cCoeff)
+          table[cCoeff] = m_offsets(cDim) + m_scales(cDim) * coeffs[cCoeff];
+
+        // de Boor recursion on local knots
+        for (int level{1}; level < m_order; ++level)
+          for (int cCoeff{m_order - 1}; cCoeff >= level; --cCoeff) {
+            const double knotL{knots[cCoeff - 1]};
+            const double knotR{knots[cCoeff + m_order - 1 - level]};
+            const double weight{(offset - knotL) / (knotR - knotL)};
+            table[cCoeff] =
+                (1.0 - weight) * table[cCoeff - 1] + weight * table[cCoeff];
+          }
+        values(cPoint, cDim) = table[m_order - 1];
+      }
+    }
+
+    return values;
+  }
+
+  /**
+   * @brief Decode the quantised spline to a spline.
+   *
+   * @return Spline spline with dequantised coefficients and knots, and the
+   * basis scale of the quantised spline.
+   */
+  Spline toSpline() const {
+    Eigen::ArrayXd knots(m_knotOffsets.size());
+    for (size_t cKnot{}; cKnot < m_knotOffsets.size(); ++cKnot)
+      knots(cKnot) = m_knotFirst + getKnot(cKnot);
+
+    Eigen::MatrixXd coeffs(m_numCoeffs, m_dim);
+    for (int cDim{}; cDim < m_dim; ++cDim) {
+      const int16_t *coeffsDim{
+          &m_coefficients[static_cast<size_t>(cDim) * m_numCoeffs]};
+      for (int cCoeff{}; cCoeff < m_numCoeffs; ++cCoeff)
+        coeffs(cCoeff, cDim) =
+            m_offsets(cDim) + m_scales(cDim) * coeffsDim[cCoeff];
+    }
+
+    return {BasisPool::makeBasis({std::move(knots), m_order, m_basisScale}),
+            std::move(coeffs)};
+  }
+
+  /**
+   * @brief Get the maximum error of the quantised spline on the spline domain.
+   *
+   * @return double maximum absolute error.
+   */
+  double getMaxError() const { return m_maxError; }
+
+  /**
+   * @brief Get the number of bytes occupied by coefficients, knots, scales,
+   * offsets and the basis scale.
+   *
+   * @return size_t number of bytes of the quantised data.
+   */
+  size_t getBytes() const {
+    return m_coefficients.size() * sizeof(int16_t) +
+           m_knotOffsets.size() * sizeof(uint32_t) +
+           2 * static_cast<size_t>(m_dim) * sizeof(double) +
+           3 * sizeof(double);
+  }
+
+  /**
+   * @brief Get the spline output dimensionality.
+   *
+   * @return int spline output dimensionality.
+   */
+  int dim() const { return m_dim; }
+
+private:
+  // MARK: private properties
+
+  std::vector<int16_t> m_coefficients{}; /**<< quantised coefficients */
+  Eigen::ArrayXd m_scales{};             /**<< coefficient scales */
+  Eigen::ArrayXd m_offsets{};            /**<< coefficient offsets */
+  std::vector<uint32_t> m_knotOffsets{}; /**<< knot offsets to first knot */
+  double m_knotFirst{};                  /**<< first knot */
+  double m_knotStep{};                   /**<< knot offset resolution */
+  double m_maxError{};                   /**<< maximum quantisation error */
+  double m_basisScale{};                 /**<< scaling factor of the knots */
+  int m_order{};                         /**<< basis order */
+  int m_numCoeffs{};                     /**<< basis dimensionality */
+  int m_dim{};                           /**<< output dimensionality */
+  int m_spanFirst{};                     /**<< first non-empty span */
+  int m_spanLast{};                      /**<< last non-empty span */
+
+  // MARK: private methods
+
+  /**
+   * @brief Decode the offset of the knot "idx" to the first knot.
+   *
+   * @param idx knot index.
+   * @return double knot offset.
+   */
+  double getKnot(size_t idx) const { return m_knotOffsets[idx] * m_knotStep; }
+};
+}; // namespace BasisSplines
+
+#endif
@@ -0,0 +1,230 @@
+#ifndef RATIONAL_SPLINE_H
+#define RATIONAL_SPLINE_H
+
+#include <Eigen/Core>
+#include <memory>
+#include <vector>
+
+#include "basisSplines/basis.h"
+#include "basisSplines/spline.h"
+
+namespace BasisSplines {
+/**
+ * @brief Rational spline in basis form (NURBS).
+ *
+ * Represents a multidimensional rational spline R(t) determined by its control
+ * points P, weights w, and a basis B(t).
+ *
+ * R(t) = (P^T W B(t)) / (w^T B(t))
+ *
+ * The rational spline is stored as a polynomial spline in homogeneous
+ * coordinates, whose coefficients are the weighted control points W P and the
+ * weights w in the last column. The derivative splines of the homogeneous
+ * spline are determined once on construction and determined anew if the basis
+ * was modified afterwards.
+ */
+class RationalSpline {
+public:
+  // MARK: public methods
+  RationalSpline() = default;
+
+  /**
+   * @brief Construct a new rational spline from a "basis", the "controlPoints"
+   * and the "weights". The number of "controlPoints" rows and "weights" must
+   * correspond with the "basis" dimensionality.
+   *
+   * @param basis spline basis.
+   * @param controlPoints spline control points.
+   * @param weights positive control point weights.
+   */
+  RationalSpline(std::shared_ptr<Basis> basis,
+                 const Eigen::MatrixXd &controlPoints,
+                 const Eigen::VectorXd &weights) {
+    assert(controlPoints.rows() == weights.size() &&
+           "Control points must have same rows as weights.");
+    assert((weights.array() > 0.0).all() && "Weights must be positive.");
+
+    Eigen::MatrixXd coeffs(controlPoints.rows(), controlPoints.cols() + 1);
+    coeffs << controlPoints.array().colwise() * weights.array(), weights;
+    m_homogeneous = {std::move(basis), std::move(coeffs)};
+    setDerivatives();
+  }
+
+  /**
+   * @brief Construct a new rational spline from its "homogeneous"
+   * representation, whose last output dimension contains the weights.
+   *
+   * @param homogeneous spline in homogeneous coordinates.
+   */
+  explicit RationalSpline(Spline homogeneous)
+      : m_homogeneous{std::move(homogeneous)} {
+    assert(m_homogeneous.dim() > 1 &&
+           "Homogeneous spline requires weight dimension.");
+    setDerivatives();
+  }
+
+  /**
+   * @brief Get the spline in homogeneous coordinates.
+   *
+   * @return const Spline& homogeneous spline.
+   */
+  const Spline &homogeneous() const { return m_homogeneous; }
+
+  /**
+   * @brief Get the spline basis.
+   *
+   * @return const std::shared_ptr<Basis> spline basis.
+   */
+  const std::shared_ptr<Basis> basis() const { return m_homogeneous.basis(); }
+
+  /**
+   * @brief Get the control points.
+   *
+   * @return Eigen::MatrixXd control points with basis dimensionality rows and
+   * output dimensionality columns.
+   */
+  Eigen::MatrixXd getControlPoints() const {
+    const Eigen::MatrixXd &coeffs{m_homogeneous.getCoefficients()};
+    return coeffs.leftCols(dim()).array().colwise() /
+           coeffs.col(dim()).array();
+  }
+
+  /**
+   * @brief Get the control point weights.
+   *
+   * @return Eigen::VectorXd weights.
+   */
+  Eigen::VectorXd getWeights() const {
+    return m_homogeneous.getCoefficients().col(dim());
+  }
+
+  /**
+   * @brief Get the spline output dimensionality.
+   *
+   * @return int spline output dimensionality.
+   */
+  int dim() const { return m_homogeneous.dim() - 1; }
+
+  /**
+   * @brief Evaluate rational spline at given "points".
+   * The weighted control points and the weights are evaluated with a single
+   * basis evaluation.
+   *
+   * @param points evaluation points.
+   * @return Eigen::ArrayXXd spline values with "points.size()" rows and
+   * "dim()" columns.
+   */
+  Eigen::ArrayXXd operator()(const Eigen::ArrayXd &points) const {
+    const Eigen::ArrayXXd values{m_homogeneous(points)};
+    return values.leftCols(dim()).colwise() / values.col(dim());
+  }
+
+  /**
+   * @brief Evaluate the derivative of order "orderDer" at given "points".
+   *
+   * The derivatives C^(k) follow from the derivatives A^(k) and w^(k) of the
+   * homogeneous spline by the quotient rule [1, Ch. 4.3]
+   *
+   * C^(k) = (A^(k) - sum_{i=1}^{k} binom(k, i) w^(i) C^(k-i)) / w.
+   *
+   * [1] L. Piegl and W. Tiller, The NURBS Book, 2nd ed. Berlin, Germany:
+   * Springer, 1997, doi: 10.1007/978-3-642-59223-2.
+   *
+   * @param points evaluation points.
+   * @param orderDer derivative order.
+   * @return Eigen::ArrayXXd derivative values with "points.size()" rows and
+   * "dim()" columns.
+   */
+  Eigen::ArrayXXd derivative(const Eigen::ArrayXd &points,
+                             int orderDer = 1) const {
+    assert(orderDer >= 0 && "Derivative order must be positive.");
+
+    // stored derivatives are outdated if the basis was modified
+    const bool isOutdated{m_homogeneous.basis()->hash() != m_basisHash};
+    const std::vector<Spline> homDerivsNew{
+        isOutdated ? getDerivatives() : std::vector<Spline>{}};
+    const std::vector<Spline> &homDerivSplines{isOutdated ? homDerivsNew
+                                                          : m_homDerivs};
+
+    // homogeneous derivatives until "orderDer", zero from the basis order on
+    std::vector<Eigen::ArrayXXd> homDerivs{m_homogeneous(points)};
+    for (int cOrder{1}; cOrder <= orderDer; ++cOrder)
+      homDerivs.push_back(
+          cOrder <= static_cast<int>(homDerivSplines.size())
+              ? homDerivSplines[cOrder - 1](points)
+              : Eigen::ArrayXXd::Zero(points.size(), dim() + 1));
+
+    // rational derivatives by quotient rule
+    const Eigen::ArrayXd weights{homDerivs[0].col(dim())};
+    std::vector<Eigen::ArrayXXd> derivs{};
+    for (int cOrder{}; cOrder <= orderDer; ++cOrder) {
+      Eigen::ArrayXXd numerator{homDerivs[cOrder].leftCols(dim())};
+      double binom{1.0};
+      for (int cTerm{1}; cTerm <= cOrder; ++cTerm) {
+        binom = binom * (cOrder - cTerm + 1) / cTerm;
+        numerator -= binom * (derivs[cOrder - cTerm].colwise() *
+                              homDerivs[cTerm].col(dim()));
+      }
+      derivs.push_back(numerator.colwise() / weights);
+    }
+
+    return derivs[orderDer];
+  }
+
+  /**
+   * @brief Create equivalent rational spline with inserted knots.
+   * The knots are inserted into the homogeneous spline.
+   *
+   * @param knots knot values to be inserted.
+   * @return RationalSpline new rational spline with the inserted knots.
+   */
+  RationalSpline insertKnots(const Eigen::ArrayXd &knots) const {
+    return RationalSpline{m_homogeneous.insertKnots(knots)};
+  }
+
+  /**
+   * @brief Create equivalent rational spline with inserted knot.
+   *
+   * @param knot knot value to be inserted.
+   * @return RationalSpline new rational spline with the inserted knot.
+   */
+  RationalSpline insertKnot(double knot) const {
+    return RationalSpline{m_homogeneous.insertKnot(knot)};
+  }
+
+private:
+  // MARK: private properties
+
+  Spline m_homogeneous{}; /**<< spline in homogeneous coordinates */
+  std::vector<Spline> m_homDerivs{}; /**<< homogeneous derivatives by order */
+  size_t m_basisHash{}; /**<< basis hash when determining the derivatives */
+
+  // MARK: private methods
+
+  /**
+   * @brief Determine the derivatives of the homogeneous spline of the orders
+   * 1 to "order - 1". Higher derivatives are zero.
+   *
+   * @return std::vector<Spline> homogeneous derivatives by order.
+   */
+  std::vector<Spline> getDerivatives() const {
+    std::vector<Spline> homDerivs{};
+    for (int cOrder{1}; cOrder < m_homogeneous.basis()->order(); ++cOrder)
+      homDerivs.push_back(cOrder == 1 ? m_homogeneous.derivative()
+                                      : homDerivs.back().derivative());
+    return homDerivs;
+  }
+
+  /**
+   * @brief Store the derivatives of the homogeneous spline and the hash of its
+   * basis.
+   *
+   */
+  void setDerivatives() {
+    m_homDerivs = getDerivatives();
+    m_basisHash = m_homogeneous.basis()->hash();
+  }
+};
+}; // namespace BasisSplines
+
+#endif
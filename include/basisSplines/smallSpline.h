@@ -0,0 +1,297 @@
+#ifndef SMALL_SPLINE_H
+#define SMALL_SPLINE_H
+
+#include <Eigen/Core>
+#include <memory>
+#include <stdexcept>
+
+#include "basisSplines/basis.h"
+#include "basisSplines/basisPool.h"
+#include "basisSplines/spline.h"
+
+namespace BasisSplines {
+
+/**
+ * @brief Basis with inline knot storage for at most SmallBasis::maxKnots
+ * knots.
+ *
+ * The knots are stored in a fixed capacity array without heap allocation,
+ * such that creating and copying small bases is not limited by the allocator.
+ * The basis is convertible to and from Basis.
+ */
+class SmallBasis {
+public:
+  static constexpr int maxKnots{32}; /**<< knot capacity */
+
+  using Knots =
+      Eigen::Array<double, Eigen::Dynamic, 1, 0, maxKnots, 1>; /**<< knots */
+  using Values =
+      Eigen::Matrix<double, Eigen::Dynamic, 1, 0, maxKnots, 1>; /**<< values */
+
+  // MARK: public methods
+  SmallBasis() = default;
+
+  /**
+   * @brief Construct a new small basis for the given "knots", "order", and
+   * knot "scale". Throws std::invalid_argument if the number of knots exceeds
+   * SmallBasis::maxKnots.
+   *
+   * @tparam Derived type of the knot array.
+   * @param knots knot locations.
+   * @param order basis order.
+   * @param scale knot scaling factor.
+   */
+  template <typename Derived>
+  SmallBasis(const Eigen::ArrayBase<Derived> &knots, int order,
+             double scale = 1.0)
+      : m_order{order}, m_scale{scale} {
+    if (knots.size() > maxKnots)
+      throw std::invalid_argument(
+          "Number of knots exceeds SmallBasis::maxKnots.");
+    m_knots = knots;
+  }
+
+  /**
+   * @brief Construct a new small basis from the "basis". Throws
+   * std::invalid_argument if the number of knots exceeds SmallBasis::maxKnots.
+   *
+   * @param basis basis to copy.
+   */
+  explicit SmallBasis(const Basis &basis)
+      : SmallBasis{basis.knots(), basis.order(), basis.getScale()} {}
+
+  /**
+   * @brief Convert to a basis with heap knot storage.
+   *
+   * @return Basis basis with equal knots, order and scale.
+   */
+  Basis toBasis() const { return {m_knots, m_order, m_scale}; }
+
+  /**
+   * @brief Get the basis knots.
+   *
+   * @return const Knots& basis knots.
+   */
+  const Knots &knots() const { return m_knots; }
+
+  /**
+   * @brief Get the basis order.
+   *
+   * @return int basis order.
+   */
+  int order() const { return m_order; }
+
+  /**
+   * @brief Get the basis dimensionality.
+   *
+   * @return int number of basis functions.
+   */
+  int dim() const { return static_cast<int>(m_knots.size()) - m_order; }
+
+  /**
+   * @brief Get the basis scaling factor.
+   *
+   * @return double scaling factor.
+   */
+  double getScale() const { return m_scale; }
+
+  /**
+   * @brief Determine the knot span containing "point", see Basis::getSpan.
+   *
+   * @param point query point.
+   * @param accSegment accuracy for assigning points outside the knots.
+   * @return int index of the first span knot or -1 if "point" is outside the
+   * knots.
+   */
+  int getSpan(double point, double accSegment = 1e-6) const {
+    return Basis::getSpan(m_knots, point, accSegment);
+  }
+
+  /**
+   * @brief Evaluate the basis functions that are non-zero on the knot "span"
+   * at "point", see Basis::evalSpan.
+   *
+   * @param point evaluation point.
+   * @param span knot span containing "point".
+   * @param values "order" basis values.
+   * @param accBps minimum distance between breakpoints.
+   */
+  void evalSpan(double point, int span, Eigen::Ref<Eigen::VectorXd> values,
+                double accBps = 1e-6) const {
+    Basis::evalSpan(m_knots, m_order, point, span, values, accBps);
+  }
+
+private:
+  // MARK: private properties
+
+  Knots m_knots{};     /**<< inline basis knots */
+  int m_order{};       /**<< basis order */
+  double m_scale{1.0}; /**<< knot scaling factor */
+};
+
+/**
+ * @brief Spline with inline storage of at most SmallBasis::maxKnots knots and
+ * SmallSpline::maxDim output dimensions.
+ *
+ * In contrast to Spline, the basis is held by value and the coefficients are
+ * stored in a fixed capacity matrix. Creating, copying, evaluating and
+ * differentiating small splines requires no heap allocation. The spline is
+ * convertible to and from Spline.
+ */
+class SmallSpline {
+public:
+  static constexpr int maxDim{4}; /**<< output dimensionality capacity */
+
+  using Coefficients =
+      Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, 0,
+                    SmallBasis::maxKnots, maxDim>; /**<< coefficients */
+  using Values = Eigen::Matrix<double, Eigen::Dynamic, 1, 0, maxDim,
+                               1>; /**<< values at a point */
+
+  // MARK: public methods
+  SmallSpline() = default;
+
+  /**
+   * @brief Construct a new small spline from a "basis" and the
+   * "coefficients". The number of "coefficients" rows must correspond with the
+   * "basis" dimensionality. Throws std::invalid_argument if the number of
+   * columns exceeds SmallSpline::maxDim.
+   *
+   * @tparam Derived type of the coefficient matrix.
+   * @param basis spline basis.
+   * @param coefficients spline coefficients.
+   */
+  template <typename Derived>
+  SmallSpline(const SmallBasis &basis,
+              const Eigen::MatrixBase<Derived> &coefficients)
+      : m_basis{basis} {
+    assert(coefficients.rows() == basis.dim() &&
+           "Coefficients must have same rows as basis dimensionality.");
+    if (coefficients.cols() > maxDim)
+      throw std::invalid_argument(
+          "Output dimensionality exceeds SmallSpline::maxDim.");
+    m_coefficients = coefficients;
+  }
+
+  /**
+   * @brief Construct a new small spline from the "spline". Throws
+   * std::invalid_argument if the spline exceeds the capacity.
+   *
+   * @param spline spline to copy.
+   */
+  explicit SmallSpline(const Spline &spline)
+      : SmallSpline{SmallBasis{*spline.basis()}, spline.getCoefficients()} {}
+
+  /**
+   * @brief Convert to a spline with heap storage. The basis is interned in the
+   * global BasisPool if enabled.
+   *
+   * @return Spline spline with equal basis and coefficients.
+   */
+  Spline toSpline() const {
+    return {BasisPool::makeBasis(m_basis.toBasis()),
+            Eigen::MatrixXd{m_coefficients}};
+  }
+
+  /**
+   * @brief Get the spline basis.
+   *
+   * @return const SmallBasis& spline basis.
+   */
+  const SmallBasis &basis() const { return m_basis; }
+
+  /**
+   * @brief Get the spline coefficients.
+   *
+   * @return const Coefficients& spline coefficients.
+   */
+  const Coefficients &getCoefficients() const { return m_coefficients; }
+
+  /**
+   * @brief Get the spline output dimensionality.
+   *
+   * @return int spline output dimensionality.
+   */
+  int dim() const { return static_cast<int>(m_coefficients.cols()); }
+
+  /**
+   * @brief Evaluate the spline at "point". Points more than "accSegment"
+   * outside the knots evaluate to zero.
+   *
+   * @param point evaluation point.
+   * @param accSegment accuracy for assigning points outside the knots.
+   * @return Values spline values with "dim()" entries.
+   */
+  Values operator()(double point, double accSegment = 1e-6) const {
+    Values values{Values::Zero(dim())};
+    const int span{m_basis.getSpan(point, accSegment)};
+    if (span < 0)
+      return values;
+
+    // basis functions non-zero on span
+    const int order{m_basis.order()};
+    SmallBasis::Values basisValues(order);
+    m_basis.evalSpan(point, span, basisValues);
+
+    const int first{span - order + 1};
+    for (int cFunc{std::max(-first, 0)};
+         cFunc < order && first + cFunc < m_coefficients.rows(); ++cFunc)
+      values += basisValues(cFunc) * m_coefficients.row(first + cFunc);
+    return values;
+  }
+
+  /**
+   * @brief Evaluate the spline at given "points".
+   *
+   * @param points evaluation points.
+   * @return Eigen::ArrayXXd spline values with "points.size()" rows and
+   * "dim()" columns.
+   */
+  Eigen::ArrayXXd operator()(const Eigen::ArrayXd &points) const {
+    Eigen::ArrayXXd values(points.size(), dim());
+    for (Eigen::Index cPoint{}; cPoint < points.size(); ++cPoint)
+      values.row(cPoint) = (*this)(points(cPoint)).transpose().array();
+    return values;
+  }
+
+  /**
+   * @brief Create new small spline as derivative of this spline, which
+   * coincides with Spline::derivative.
+   *
+   * @param orderDer derivative order.
+   * @return SmallSpline derivative of "orderDer".
+   */
+  SmallSpline derivative(int orderDer = 1) const {
+    assert(orderDer >= 0 && orderDer < m_basis.order() &&
+           "Derivative order must be positive and less than order.");
+
+    SmallSpline deriv{*this};
+    for (int level{}; level < orderDer; ++level) {
+      const SmallBasis &basis{deriv.m_basis};
+      const SmallBasis::Knots &knots{basis.knots()};
+      const int order{basis.order()};
+
+      // coefficient differences [Boo01, B-spline prop. (viii)]
+      Coefficients &coeffs{deriv.m_coefficients};
+      for (int idx{}; idx < basis.dim() - 1; ++idx)
+        coeffs.row(idx) =
+            (order - 1) * (coeffs.row(idx + 1) - coeffs.row(idx)) /
+            (knots(idx + order) - knots(idx + 1)) / basis.getScale();
+      coeffs.conservativeResize(basis.dim() - 1, Eigen::NoChange);
+
+      // derivative basis with unit scale as Basis::orderDecrease
+      deriv.m_basis =
+          SmallBasis{knots.segment(1, knots.size() - 2), order - 1};
+    }
+    return deriv;
+  }
+
+private:
+  // MARK: private properties
+
+  SmallBasis m_basis{};          /**<< spline basis */
+  Coefficients m_coefficients{}; /**<< inline spline coefficients */
+};
+}; // namespace BasisSplines
+
+#endif
@@ -2,10 +2,24 @@
 #define SPLINE_H
 
 #include <Eigen/Core>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <limits>
 #include <memory>
+#include <memory_resource>
+#include <numeric>
+#include <vector>
 
 #include "basisSplines/basis.h"
+#include "basisSplines/basisPool.h"
+#include "basisSplines/cpuDispatch.h"
+#include "basisSplines/executor.h"
 #include "basisSplines/interpolate.h"
+#include "basisSplines/math.h"
+#include "basisSplines/splineWorkspace.h"
+#include "basisSplines/transformCache.h"
 
 namespace BasisSplines {
 /**
@@ -25,15 +39,14 @@ public:
   /**
    * @brief Construct a new spline in basis form from a "basis" spline and the
    * "coefficients". The number of "coefficients" rows must correspond with the
-   * "basis" dimensionality.
+   * "basis" dimensionality. Rvalue "coefficients" are moved into the spline.
    *
    * @param basis spline basis.
    * @param coefficients spline coefficients.
    */
-  Spline(const std::shared_ptr<Basis> basis,
-         const Eigen::MatrixXd &coefficients)
-      : m_basis{basis}, m_coefficients{coefficients} {
-    assert(coefficients.rows() == basis->dim() &&
+  Spline(std::shared_ptr<Basis> basis, Eigen::MatrixXd coefficients)
+      : m_basis{std::move(basis)}, m_coefficients{std::move(coefficients)} {
+    assert(m_coefficients.rows() == m_basis->dim() &&
            "Coefficients must have same rows as basis dimensionality.");
   }
 
@@ -44,20 +57,29 @@ public:
    *
    * @return const Eigen::ArrayXd& spline coefficients.
    */
-  const Eigen::MatrixXd &getCoefficients() const { return m_coefficients; }
+  const Eigen::MatrixXd &getCoefficients() const & { return m_coefficients; }
+
+  /**
+   * @brief Get the coefficients of an expiring spline by moving them out of
+   * the spline.
+   *
+   * @return Eigen::MatrixXd spline coefficients.
+   */
+  Eigen::MatrixXd getCoefficients() && { return std::move(m_coefficients); }
 
   /**
    * @brief Set the spline coefficients.
    * The coefficients' size must equal the spline's coefficients' size.
+   * Rvalue "coefficients" are moved into the spline.
    *
    * @param coefficients new spline coefficients.
    */
-  void setCoefficients(const Eigen::MatrixXd coefficients) {
+  void setCoefficients(Eigen::MatrixXd coefficients) {
     assert(coefficients.rows() == m_coefficients.rows() &&
            "Coefficients must have same rows as spline coefficients.");
     assert(coefficients.cols() == m_coefficients.cols() &&
            "Coefficients must have same columns as spline coefficients.");
-    m_coefficients = coefficients;
+    m_coefficients = std::move(coefficients);
   }
 
   /**
@@ -74,6 +96,21 @@ public:
    */
   int dim() const { return m_coefficients.cols(); }
 
+  /**
+   * @brief Create new spline of the output dimensions "dims" of "this"
+   * spline. The basis is shared and only the coefficient columns of "dims" are
+   * copied.
+   *
+   * @param dims output dimensions in [0, Spline::dim()).
+   * @return Spline spline with the output dimensions "dims".
+   */
+  Spline select(const Eigen::ArrayXi &dims) const {
+    assert((dims.size() == 0 ||
+            (dims.minCoeff() >= 0 && dims.maxCoeff() < dim())) &&
+           "Output dimensions must be in [0, dim()).");
+    return {m_basis, m_coefficients(Eigen::all, dims)};
+  }
+
   /**
    * @brief Evaluate spline at given "points".
    * The number of output rows corresponds with the number of "points".
@@ -81,13 +118,113 @@ public:
    * dimensionality.
    * [Boo01, def. (51)]
    *
+   * At least Spline::getSortedThreshold "points" are evaluated with
+   * Spline::evalSorted.
+   *
    * @param points evaluation points.
    * @return Eigen::ArrayXd spline function values at "points".
    */
   Eigen::ArrayXXd operator()(const Eigen::ArrayXd &points) const {
+    if (points.size() >= s_sortedThreshold)
+      return evalSorted(points);
     return (m_basis->operator()(points) * m_coefficients);
   }
 
+  /**
+   * @brief Evaluate the output dimensions "dims" of the spline at given
+   * "points". Only the coefficient columns of "dims" are read, see
+   * Spline::select.
+   *
+   * @param points evaluation points.
+   * @param dims output dimensions in [0, Spline::dim()).
+   * @return Eigen::ArrayXXd spline function values with one row per point and
+   * one column per output dimension in "dims".
+   */
+  Eigen::ArrayXXd operator()(const Eigen::ArrayXd &points,
+                             const Eigen::ArrayXi &dims) const {
+    return select(dims)(points);
+  }
+
+  /**
+   * @brief Evaluate spline at given unsorted "points" span by span.
+   *
+   * The points are bucketed by their knot span with a counting sort on the
+   * span index. Each bucket is evaluated with the basis functions non-zero on
+   * its span and the corresponding "order" coefficient rows by the kernel of
+   * the active instruction set level, see CpuDispatch. The values are
+   * scattered back to the order of "points".
+   *
+   * @param points evaluation points.
+   * @return Eigen::ArrayXXd spline function values at "points".
+   */
+  Eigen::ArrayXXd evalSorted(const Eigen::ArrayXd &points) const {
+    const int order{m_basis->order()};
+    if (order > CpuDispatch::s_maxOrder)
+      return m_basis->operator()(points) * m_coefficients;
+    const int numSpans{static_cast<int>(m_basis->knots().size()) - 1};
+    const int numCoeffs{static_cast<int>(m_coefficients.rows())};
+
+    // span of each point, -1 for points outside the knots
+    std::pmr::memory_resource *resource{SplineWorkspace::resource()};
+    std::pmr::vector<int> spans(points.size(), resource);
+    Executor::parallelFor(
+        0, points.size(), [&](Eigen::Index begin, Eigen::Index end) {
+          for (Eigen::Index cPoint{begin}; cPoint < end; ++cPoint)
+            spans[cPoint] = m_basis->getSpan(points(cPoint));
+        });
+
+    // counting sort of the point indices by span
+    std::pmr::vector<int> offsets(numSpans + 2, resource);
+    for (int span : spans)
+      ++offsets[span + 2];
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    std::pmr::vector<int> sorted(points.size(), resource);
+    for (int cPoint{}; cPoint < static_cast<int>(points.size()); ++cPoint)
+      sorted[offsets[spans[cPoint] + 1]++] = cPoint;
+
+    // evaluate bucket by bucket with the dispatched kernel, points outside the
+    // knots remain zero, chunks hold about Executor::getGrainSize() points
+    Eigen::ArrayXXd values{Eigen::ArrayXXd::Zero(points.size(), dim())};
+    const Eigen::ArrayXd &knots{m_basis->knots()};
+    const Eigen::Index grainSpans{Executor::getGrainSize() * numSpans /
+                                  std::max<Eigen::Index>(points.size(), 1)};
+    Executor::parallelFor(
+        0, numSpans,
+        [&](Eigen::Index begin, Eigen::Index end) {
+          for (int span{static_cast<int>(begin)}; span < end; ++span)
+            if (offsets[span] < offsets[span + 1])
+              CpuDispatch::evalSpan(knots.data(),
+                                    static_cast<int>(knots.size()), order,
+                                    span, m_coefficients.data(), numCoeffs,
+                                    dim(), points.data(),
+                                    sorted.data() + offsets[span],
+                                    offsets[span + 1] - offsets[span],
+                                    values.data(), values.rows(), 1e-6);
+        },
+        grainSpans);
+
+    return values;
+  }
+
+  /**
+   * @brief Get the number of points from which on Spline::operator() uses
+   * Spline::evalSorted.
+   *
+   * @return int minimum number of points for span-sorted evaluation.
+   */
+  static int getSortedThreshold() { return s_sortedThreshold; }
+
+  /**
+   * @brief Set the number of points from which on Spline::operator() uses
+   * Spline::evalSorted. The threshold is shared by all splines and must not be
+   * changed during concurrent evaluations.
+   *
+   * @param threshold minimum number of points for span-sorted evaluation.
+   */
+  static void setSortedThreshold(int threshold) {
+    s_sortedThreshold = threshold;
+  }
+
   /**
    * @brief Create new spline with negated spline coefficients.
    *
@@ -97,6 +234,7 @@ public:
 
   /**
    * @brief Create new spline as derivative of this spline.
+   * Uses the basis of the global TransformCache if enabled.
    *
    * @param orderDer derivative order.
    * @return Spline as derivative of "orderDer".
@@ -104,13 +242,80 @@ public:
   Spline derivative(int orderDer = 1) const {
     assert(orderDer >= 0 && "Derivative order must be positive.");
 
+    if (TransformCache::global().isEnabled() && orderDer > 0 &&
+        orderDer < m_basis->order()) {
+      const auto transform{
+          TransformCache::global().derivative(*m_basis, orderDer)};
+      return {BasisPool::makeBasis(Basis{*transform->basis}),
+              getDerivativeCoefficients(orderDer)};
+    }
+
     // create derivative basis and determine coefficients
     Basis basisNew{};
     Eigen::MatrixXd coeffsNew(
         m_basis->derivative(basisNew, m_coefficients, orderDer));
 
     // return derivative spline
-    return {std::make_shared<Basis>(basisNew), coeffsNew};
+    return {BasisPool::makeBasis(std::move(basisNew)), std::move(coeffsNew)};
+  }
+
+  /**
+   * @brief Create new spline as derivative of the output dimensions "dims" of
+   * this spline. Only the coefficient columns of "dims" are transformed, see
+   * Spline::select.
+   *
+   * @param dims output dimensions in [0, Spline::dim()).
+   * @param orderDer derivative order.
+   * @return Spline derivative of "orderDer" with the output dimensions "dims".
+   */
+  Spline derivative(const Eigen::ArrayXi &dims, int orderDer = 1) const {
+    return select(dims).derivative(orderDer);
+  }
+
+  /**
+   * @brief Store the derivative of this spline in "out".
+   * The basis and coefficient storage of "out" are reused if "out" already has
+   * the derivative basis and output dimensionality. The coefficients are then
+   * transformed without allocation. Otherwise, "out" is assigned
+   * Spline::derivative.
+   *
+   * @param out derivative spline of "orderDer".
+   * @param orderDer derivative order.
+   */
+  void derivativeInto(Spline &out, int orderDer = 1) const {
+    assert(orderDer >= 0 && "Derivative order must be positive.");
+
+    const Eigen::ArrayXd &knots{m_basis->knots()};
+    const int order{m_basis->order()};
+    if (&out == this || orderDer == 0 || orderDer >= order ||
+        orderDer >= s_maxOrderInto ||
+        !out.hasBasis(order - orderDer, knots.size() - 2 * orderDer,
+                      [&](Eigen::Index idx) {
+                        return knots(idx + orderDer);
+                      }) ||
+        out.dim() != dim()) {
+      out = derivative(orderDer);
+      return;
+    }
+
+    // each row from "orderDer" differences of adjacent coefficients
+    const double scale{m_basis->getScale()};
+    std::array<double, s_maxOrderInto> diffs{};
+    for (Eigen::Index cRow{}; cRow < out.m_coefficients.rows(); ++cRow)
+      for (int cDim{}; cDim < dim(); ++cDim) {
+        for (int cDiff{}; cDiff <= orderDer; ++cDiff)
+          diffs[cDiff] = m_coefficients(cRow + cDiff, cDim);
+        for (int level{}; level < orderDer; ++level)
+          for (int cDiff{}; cDiff < orderDer - level; ++cDiff) {
+            // derivative bases following the first have unit scale
+            const Eigen::Index idx{cRow + cDiff};
+            diffs[cDiff] = (order - 1 - level) *
+                           (diffs[cDiff + 1] - diffs[cDiff]) /
+                           (knots(idx + order) - knots(idx + level + 1)) /
+                           (level == 0 ? scale : 1.0);
+          }
+        out.m_coefficients(cRow, cDim) = diffs[0];
+      }
   }
 
   /**
@@ -128,14 +333,98 @@ public:
         m_basis->integral(basisNew, m_coefficients, orderInt));
 
     // return derivative spline
-    return {std::make_shared<Basis>(basisNew), coeffsNew};
+    return {BasisPool::makeBasis(std::move(basisNew)), std::move(coeffsNew)};
+  }
+
+  /**
+   * @brief Store the integral of this spline in "out".
+   * The basis and coefficient storage of "out" are reused if "out" already has
+   * the integral basis and output dimensionality. The coefficients are then
+   * transformed without allocation. Otherwise, "out" is assigned
+   * Spline::integral.
+   *
+   * @param out integral spline of "orderInt".
+   * @param orderInt integral order.
+   */
+  void integralInto(Spline &out, int orderInt = 1) const {
+    assert(orderInt >= 0 && "Integral order must be positive.");
+
+    const Eigen::ArrayXd &knots{m_basis->knots()};
+    const Eigen::Index numKnots{knots.size()};
+    const int order{m_basis->order()};
+    const auto knotInt{[&](Eigen::Index idx) {
+      return knots(std::clamp<Eigen::Index>(idx - orderInt, 0, numKnots - 1));
+    }};
+    if (&out == this || orderInt == 0 ||
+        !out.hasBasis(order + orderInt, numKnots + 2 * orderInt, knotInt) ||
+        out.dim() != dim()) {
+      out = integral(orderInt);
+      return;
+    }
+
+    // cumulative sums in place, "carry" holds the overwritten coefficient
+    const Eigen::Index numCoeffs{m_coefficients.rows()};
+    out.m_coefficients.topRows(numCoeffs) = m_coefficients;
+    for (int level{}; level < orderInt; ++level) {
+      // knots of the integrated basis at this level
+      const int orderLevel{order + level};
+      const auto knotLevel{[&](Eigen::Index idx) {
+        return knots(std::clamp<Eigen::Index>(idx - level, 0, numKnots - 1));
+      }};
+      const double scale{level == 0 ? m_basis->getScale() : 1.0};
+
+      for (int cDim{}; cDim < dim(); ++cDim) {
+        auto coeffs{out.m_coefficients.col(cDim)};
+        double carry{coeffs(0)};
+        coeffs(0) = 0.0;
+        for (Eigen::Index idx{}; idx < numCoeffs + level; ++idx) {
+          const double next{idx + 1 < numCoeffs + level ? coeffs(idx + 1)
+                                                         : 0.0};
+          coeffs(idx + 1) =
+              carry * (knotLevel(idx + orderLevel) - knotLevel(idx)) /
+                  orderLevel * scale +
+              coeffs(idx);
+          carry = next;
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Create new spline retimed by the affine map t -> "factor" * t +
+   * "offset" of its basis knots, see Basis::affine. The new spline at
+   * "factor" * t + "offset" equals "this" spline at t. The coefficients are
+   * copied without refitting.
+   *
+   * @param factor positive factor of the knots.
+   * @param offset offset of the knots.
+   * @return Spline retimed spline.
+   */
+  Spline affine(double factor, double offset) const & {
+    return {BasisPool::makeBasis(m_basis->affine(factor, offset)),
+            m_coefficients};
+  }
+
+  /**
+   * @brief Create new spline retimed by the affine map t -> "factor" * t +
+   * "offset" of its basis knots and move the coefficients of "this" spline
+   * into it, see Spline::affine.
+   *
+   * @param factor positive factor of the knots.
+   * @param offset offset of the knots.
+   * @return Spline retimed spline.
+   */
+  Spline affine(double factor, double offset) && {
+    return {BasisPool::makeBasis(m_basis->affine(factor, offset)),
+            std::move(m_coefficients)};
   }
 
   /**
    * @brief Create new spline as sum of "this" and "other" spline.
    * Combine basis of "this" and "other" splines to create the sum basis.
    * Determine sum coefficients by interpolating the sum of this and other
-   * spline.
+   * spline. Uses the transforms of the global TransformCache if enabled.
+   * Splines with equal bases are summed by their coefficients.
    *
    * @tparam Interp type of interpolation.
    * @param other right spline summand.
@@ -147,9 +436,21 @@ public:
   template <typename Interp = Interpolate>
   Spline add(const Spline &other, double accScale = 1e-6,
              double accBps = 1e-6) const {
+    // equal bases, e.g. retimed by the same affine map, sum coefficients
+    if (*m_basis == *other.basis())
+      return {m_basis, m_coefficients + other.getCoefficients()};
+
+    if (TransformCache::global().isEnabled()) {
+      const auto transform{TransformCache::global().add<Interp>(
+          *m_basis, *other.basis(), accScale, accBps)};
+      return {BasisPool::makeBasis(Basis{*transform->basis}),
+              transform->matrices[0] * m_coefficients +
+                  transform->matrices[1] * other.getCoefficients()};
+    }
+
     // combine this and other basis to new basis
     // new basis order is maximum of this and other basis order
-    const std::shared_ptr<Basis> newBasis{std::make_shared<Basis>(
+    const std::shared_ptr<Basis> newBasis{BasisPool::makeBasis(
         m_basis->combine(*other.basis().get(),
                          std::max(m_basis->order(), other.basis()->order()),
                          accScale, accBps))};
@@ -160,11 +461,52 @@ public:
             })};
   }
 
+  /**
+   * @brief Store the sum of "this" and "other" spline in "out".
+   * If the global TransformCache is enabled, "out" keeps its basis if it
+   * equals the cached sum basis and is assigned a copy of it otherwise. Its
+   * coefficient storage is reused if the size matches. On a cache hit with
+   * reused basis and storage, no allocation is performed. Otherwise, "out" is
+   * assigned Spline::add. Splines with equal bases are summed by their
+   * coefficients.
+   *
+   * @tparam Interp type of interpolation.
+   * @param other right spline summand.
+   * @param out representation of spline sum.
+   * @param accScale accepted difference between "this" and "other" splines'
+   * basis scaling.
+   * @param accBps tolerance for assigning knots to breakpoint.
+   */
+  template <typename Interp = Interpolate>
+  void addInto(const Spline &other, Spline &out, double accScale = 1e-6,
+               double accBps = 1e-6) const {
+    if (*m_basis == *other.basis()) {
+      out.m_coefficients = m_coefficients + other.getCoefficients();
+      out.m_basis = m_basis;
+      return;
+    }
+
+    if (!TransformCache::global().isEnabled() || &out == this ||
+        &out == &other) {
+      out = add<Interp>(other, accScale, accBps);
+      return;
+    }
+
+    const auto transform{TransformCache::global().add<Interp>(
+        *m_basis, *other.basis(), accScale, accBps)};
+    assignCachedBasis(transform->basis, out);
+    out.m_coefficients.resize(transform->basis->dim(), dim());
+    out.m_coefficients.noalias() = transform->matrices[0] * m_coefficients;
+    out.m_coefficients.noalias() +=
+        transform->matrices[1] * other.getCoefficients();
+  }
+
   /**
    * @brief Create new spline as product of "this" and "other" spline.
    * Combine basis of "this" and "other" splines to create the product basis.
    * Determine product coefficients by interpolating the product of "this" and
-   * "other" spline.
+   * "other" spline. Uses the transform of the global TransformCache if
+   * enabled.
    *
    * @tparam Interp type of interpolation.
    * @param other right product spline.
@@ -176,9 +518,23 @@ public:
   template <typename Interp = Interpolate>
   Spline prod(const Spline &other, double accScale = 1e-6,
               double accBps = 1e-6) const {
+    if (TransformCache::global().isEnabled()) {
+      const auto transform{TransformCache::global().prod<Interp>(
+          *m_basis, *other.basis(), accScale, accBps)};
+
+      // product coefficients from Kronecker products of coefficient columns
+      Eigen::MatrixXd coeffs(transform->basis->dim(), dim());
+      for (int cDim{}; cDim < dim(); ++cDim)
+        coeffs.col(cDim) =
+            transform->matrices[0] *
+            kron(m_coefficients.col(cDim), other.getCoefficients().col(cDim));
+      return {BasisPool::makeBasis(Basis{*transform->basis}),
+              std::move(coeffs)};
+    }
+
     // combine this and other basis to new basis
     // new basis order is sum of this and other basis order - 1
-    const std::shared_ptr<Basis> newBasis{std::make_shared<Basis>(
+    const std::shared_ptr<Basis> newBasis{BasisPool::makeBasis(
         m_basis->combine(*other.basis().get(),
                          m_basis->order() + other.basis()->order() - 1,
                          accScale, accBps))};
@@ -189,6 +545,116 @@ public:
             })};
   }
 
+  /**
+   * @brief Store the product of "this" and "other" spline in "out".
+   * If the global TransformCache is enabled, "out" keeps its basis if it
+   * equals the cached product basis and is assigned a copy of it otherwise.
+   * Its coefficient storage is reused if the size matches. On a cache hit with
+   * reused basis and storage, no allocation is performed. Otherwise, "out" is
+   * assigned Spline::prod.
+   *
+   * @tparam Interp type of interpolation.
+   * @param other right product spline.
+   * @param out representation of spline product.
+   * @param accScale accepted difference between "this" and "other" splines'
+   * basis scaling.
+   * @param accBps tolerance for assigning knots to breakpoint.
+   */
+  template <typename Interp = Interpolate>
+  void prodInto(const Spline &other, Spline &out, double accScale = 1e-6,
+                double accBps = 1e-6) const {
+    if (!TransformCache::global().isEnabled() || &out == this ||
+        &out == &other) {
+      out = prod<Interp>(other, accScale, accBps);
+      return;
+    }
+
+    const auto transform{TransformCache::global().prod<Interp>(
+        *m_basis, *other.basis(), accScale, accBps)};
+    assignCachedBasis(transform->basis, out);
+    out.m_coefficients.resize(transform->basis->dim(), dim());
+
+    // transform applied to the Kronecker products of coefficient columns
+    // without forming them
+    const Eigen::MatrixXd &matrix{transform->matrices[0]};
+    const Eigen::MatrixXd &coeffsR{other.getCoefficients()};
+    out.m_coefficients.setZero();
+    for (int cDim{}; cDim < dim(); ++cDim)
+      for (Eigen::Index cRowL{}; cRowL < m_coefficients.rows(); ++cRowL)
+        for (Eigen::Index cRowR{}; cRowR < coeffsR.rows(); ++cRowR)
+          out.m_coefficients.col(cDim) +=
+              m_coefficients(cRowL, cDim) * coeffsR(cRowR, cDim) *
+              matrix.col(cRowL * coeffsR.rows() + cRowR);
+  }
+
+  /**
+   * @brief Create new spline as composition "this"("inner"(t)) of "this" and
+   * the 1-dimensional "inner" spline.
+   *
+   * The composition is a spline of order (k_this - 1)(k_inner - 1) + 1 on the
+   * domain of "inner". Its breakpoints are the breakpoints of "inner" and the
+   * preimages of the interior breakpoints of "this" under "inner". The
+   * continuity at each breakpoint is the minimum continuity of both splines.
+   * Determine coefficients by interpolating the composition in this exact
+   * basis. The range of "inner" must be in the domain of "this".
+   *
+   * @tparam Interp type of interpolation.
+   * @param inner 1-dimensional inner spline.
+   * @param accBps tolerance for assigning knots to breakpoint.
+   * @param accRoot tolerance for the preimages of breakpoints.
+   * @return Spline representation of spline composition.
+   */
+  template <typename Interp = Interpolate>
+  Spline compose(const Spline &inner, double accBps = 1e-6,
+                 double accRoot = 1e-10) const {
+    assert(inner.dim() == 1 && "Inner spline must be 1-dimensional.");
+
+    const int orderThis{m_basis->order()};
+    const int orderInner{inner.basis()->order()};
+    const int order{(orderThis - 1) * (orderInner - 1) + 1};
+
+    // inner breakpoints and continuities limited by composition order
+    const auto [bpsInner, contsInner] = inner.basis()->getBreakpoints(accBps);
+    std::vector<std::pair<double, int>> bpsComp{};
+    for (int cBp{}; cBp < bpsInner.size(); ++cBp)
+      bpsComp.emplace_back(bpsInner(cBp), std::min(contsInner(cBp), order - 1));
+
+    // preimages of interior breakpoints of this spline
+    const auto [bpsThis, contsThis] = m_basis->getBreakpoints(accBps);
+    for (int cBp{1}; cBp < bpsThis.size() - 1; ++cBp) {
+      const Spline shifted{inner.basis(),
+                           inner.getCoefficients().array() - bpsThis(cBp)};
+      for (double root : shifted.getRoots(0, 64, accRoot))
+        if (root > bpsInner(0) + accBps &&
+            root < bpsInner(bpsInner.size() - 1) - accBps)
+          bpsComp.emplace_back(root, std::min(contsThis(cBp), order - 1));
+    }
+
+    // merge coinciding breakpoints with their minimum continuity
+    std::sort(bpsComp.begin(), bpsComp.end());
+    Eigen::ArrayXd breakpoints(bpsComp.size());
+    Eigen::ArrayXi continuities(bpsComp.size());
+    int numBps{};
+    for (const auto &[bp, cont] : bpsComp) {
+      if (numBps > 0 && bp <= breakpoints(numBps - 1) + accBps) {
+        continuities(numBps - 1) = std::min(continuities(numBps - 1), cont);
+        continue;
+      }
+      breakpoints(numBps) = bp;
+      continuities(numBps++) = cont;
+    }
+
+    const std::shared_ptr<Basis> newBasis{BasisPool::makeBasis(
+        {Basis::toKnots(breakpoints.head(numBps), continuities.head(numBps),
+                        order),
+         order, inner.basis()->getScale()})};
+
+    // determine coefficients by interpolating the composition
+    return {newBasis, Interp{newBasis}.fit([&](const Eigen::ArrayXd &points) {
+              return Eigen::MatrixXd{(*this)(inner(points).col(0))};
+            })};
+  }
+
   /**
    * @brief Inserts multiple knots into the spline.
    *
@@ -222,11 +688,41 @@ public:
   Spline insertKnot(double knot) const {
     // create new basis with inserted knot
     const std::shared_ptr<Basis> basis{
-        std::make_shared<Basis>(m_basis->insertKnots({{knot}}))};
+        BasisPool::makeBasis(m_basis->insertKnots({{knot}}))};
 
     return {basis, interpolateCoefficients(knot)};
   }
 
+  /**
+   * @brief Store the equivalent spline with inserted "knot" in "out".
+   * The basis and coefficient storage of "out" are reused if "out" already has
+   * the basis with inserted knot and output dimensionality. The coefficients
+   * are then interpolated without allocation. Otherwise, "out" is assigned
+   * Spline::insertKnot.
+   *
+   * @param knot The knot value to insert into the spline.
+   * @param out spline with the inserted knot.
+   */
+  void insertKnotInto(double knot, Spline &out) const {
+    const Eigen::ArrayXd &knots{m_basis->knots()};
+    const Eigen::Index knotIdx{
+        std::upper_bound(knots.begin(), knots.end(), knot) - knots.begin()};
+    if (&out == this ||
+        !out.hasBasis(m_basis->order(), knots.size() + 1,
+                      [&](Eigen::Index idx) {
+                        return idx < knotIdx    ? knots(idx)
+                               : idx == knotIdx ? knot
+                                                : knots(idx - 1);
+                      }) ||
+        out.dim() != dim()) {
+      out = insertKnot(knot);
+      return;
+    }
+
+    for (int cDim{}; cDim < dim(); ++cDim)
+      interpolateCoefficients(knot, cDim, out.m_coefficients.col(cDim));
+  }
+
   /**
    * @brief Create new spline with order increased by "change".
    * The new spline coincides with "this" spline.
@@ -242,7 +738,7 @@ public:
 
     // create new basis with increased order
     const std::shared_ptr<Basis> basis{
-        std::make_shared<Basis>(m_basis->orderElevation(change))};
+        BasisPool::makeBasis(m_basis->orderElevation(change))};
 
     // determine new coefficients via interpolation
     return {basis, Interp{basis}.fit([&](const Eigen::ArrayXd &points) {
@@ -266,10 +762,35 @@ public:
    */
   std::vector<Eigen::ArrayXd> getRoots(int maxIter = 10,
                                        double accAbs = 1e-6) const {
-    std::vector<Eigen::ArrayXd> zeros(m_coefficients.cols());
+    return getRoots(Eigen::ArrayXi::LinSpaced(dim(), 0, dim() - 1), maxIter,
+                    accAbs);
+  }
 
-    for (int dim{}; dim < m_coefficients.cols(); ++dim)
-      zeros[dim] = getRoots(dim, maxIter, accAbs);
+  /**
+   * @brief Get the roots along the output dimensions "dims". Only the
+   * coefficient columns of "dims" are read, see Spline::getRoots.
+   *
+   * @param dims output dimensions in [0, Spline::dim()).
+   * @param maxIter Maximum number of iterations.
+   * @param accAbs Tolerance for the spline output to be considered zero.
+   * @return std::vector<Eigen::ArrayXd> Roots along the output dimensions
+   * "dims".
+   */
+  std::vector<Eigen::ArrayXd> getRoots(const Eigen::ArrayXi &dims,
+                                       int maxIter = 10,
+                                       double accAbs = 1e-6) const {
+    std::vector<Eigen::ArrayXd> zeros(dims.size());
+
+    // output dimensions in parallel, chunks hold about
+    // Executor::getGrainSize() coefficients
+    Executor::parallelFor(
+        0, dims.size(),
+        [&](Eigen::Index begin, Eigen::Index end) {
+          for (Eigen::Index cDim{begin}; cDim < end; ++cDim)
+            zeros[cDim] = getRoots(dims(cDim), maxIter, accAbs);
+        },
+        Executor::getGrainSize() /
+            std::max<Eigen::Index>(m_coefficients.rows(), 1));
 
     return zeros;
   }
@@ -293,13 +814,26 @@ public:
                           double accAbs = 1e-6) const {
     auto [rootIdcs, roots] = getRootIdcs(dim, accAbs);
 
-    int cntRoot{};
-    for (int rootIdx : rootIdcs) {
-      if (rootIdx >= 0)
-        roots(cntRoot++) = estimateRoot(rootIdx, dim, maxIter, accAbs);
-    }
-
-    return roots;
+    // estimate non-trivial roots in parallel, each estimate refines the spline
+    // about "maxIter" times
+    Executor::parallelFor(
+        0, rootIdcs.size(),
+        [&](Eigen::Index begin, Eigen::Index end) {
+          for (Eigen::Index cRoot{begin}; cRoot < end; ++cRoot)
+            if (rootIdcs(cRoot) >= 0)
+              roots(cRoot) =
+                  estimateRoot(rootIdcs(cRoot), dim, maxIter, accAbs);
+        },
+        Executor::getGrainSize() /
+            std::max<Eigen::Index>(maxIter * m_coefficients.rows(), 1));
+
+    // remove coefficient pairs without root
+    Eigen::Index cntRoot{};
+    for (double root : roots)
+      if (!std::isnan(root))
+        roots(cntRoot++) = root;
+
+    return roots.head(cntRoot);
   }
 
   /**
@@ -316,7 +850,7 @@ public:
 
     // determine basis representation of segments
     const std::shared_ptr<Basis> basisSeg{
-        std::make_shared<Basis>(m_basis->getSegment(begin, end))};
+        BasisPool::makeBasis(m_basis->getSegment(begin, end))};
 
     // determine indices of coefficients of semgnet
     int firstCoeff{static_cast<int>(begin - m_basis->knots().begin())};
@@ -337,7 +871,7 @@ public:
   template <typename Interp = Interpolate> Spline getClamped() const {
     // determine clamped basis
     const std::shared_ptr<Basis> basisClamped{
-        std::make_shared<Basis>(m_basis->getClamped())};
+        BasisPool::makeBasis(m_basis->getClamped())};
 
     // determine clamped spline coefficients by fitting clamped basis to this
     // spline
@@ -347,13 +881,265 @@ public:
             })};
   }
 
+  /**
+   * @brief Determine the Bezier control points of the polynomial piece on the
+   * knot span ["knots(span)", "knots(span + 1)"].
+   *
+   * The control points are the blossoms of the piece evaluated at the span
+   * ends [Boo01, Ch. IX]. The span must be non-empty and inside the spline
+   * domain, i.e. "order - 1 <= span < dim".
+   *
+   * @param span index of the first knot of the span.
+   * @return Eigen::MatrixXd control points with "order" rows and "dim()"
+   * columns.
+   */
+  Eigen::MatrixXd getBezier(int span) const {
+    const Eigen::ArrayXd &knots{m_basis->knots()};
+    const int degree{m_basis->order() - 1};
+    assert(span >= degree && span < m_basis->dim() &&
+           "Span must be inside the spline domain.");
+    assert(knots(span) < knots(span + 1) && "Span must not be empty.");
+
+    Eigen::MatrixXd controlPoints(degree + 1, dim());
+    for (int cPoint{}; cPoint <= degree; ++cPoint) {
+      // de Boor algorithm with "degree - cPoint" left and "cPoint" right
+      // span ends as blossom arguments
+      Eigen::MatrixXd local{m_coefficients.middleRows(span - degree, degree + 1)};
+      for (int level{1}; level <= degree; ++level) {
+        const double arg{level <= degree - cPoint ? knots(span)
+                                                  : knots(span + 1)};
+        for (int cRow{degree}; cRow >= level; --cRow) {
+          const int knotIdx{span - degree + cRow};
+          const double weight{(arg - knots(knotIdx)) /
+                              (knots(knotIdx + degree + 1 - level) -
+                               knots(knotIdx))};
+          local.row(cRow) =
+              (1.0 - weight) * local.row(cRow - 1) + weight * local.row(cRow);
+        }
+      }
+      controlPoints.row(cPoint) = local.row(degree);
+    }
+
+    return controlPoints;
+  }
+
+  /**
+   * @brief Approximate the spline with a polyline whose distance to the spline
+   * does not exceed "tolerance" and pass its vertices to "sink".
+   *
+   * Each polynomial piece is converted to Bezier form and subdivided with the
+   * de Casteljau algorithm until its control polygon is flat, i.e. each
+   * control point deviates at most "tolerance" from the chord of the first and
+   * last control point. Since the chord represents the linear interpolation of
+   * the piece, the flatness bounds the distance between spline and polyline.
+   * The vertices are emitted in increasing order without storing the
+   * polyline.
+   *
+   * @param tolerance maximum distance between spline and polyline.
+   * @param sink receives each vertex as point and spline value.
+   * @param maxDepth maximum recursion depth of the subdivision of each
+   * polynomial piece, which emits at most 2^maxDepth segments per piece.
+   */
+  void flatten(double tolerance,
+               const std::function<void(double, const Eigen::VectorXd &)> &sink,
+               int maxDepth = 32) const {
+    assert(tolerance > 0.0 && "Tolerance must be positive.");
+
+    const Eigen::ArrayXd &knots{m_basis->knots()};
+    Eigen::VectorXd valuePrev{};
+    for (int span{m_basis->order() - 1}; span < m_basis->dim(); ++span) {
+      // skip empty spans at knots with multiplicity
+      if (knots(span) >= knots(span + 1))
+        continue;
+
+      const Eigen::MatrixXd controlPoints{getBezier(span)};
+
+      // emit first vertex and vertices at discontinuities
+      const Eigen::VectorXd valueBegin{controlPoints.row(0).transpose()};
+      if (valuePrev.size() == 0 ||
+          (valueBegin - valuePrev).norm() > tolerance)
+        sink(knots(span), valueBegin);
+
+      flattenBezier(controlPoints, knots(span), knots(span + 1), tolerance,
+                    sink, maxDepth);
+      valuePrev = controlPoints.row(controlPoints.rows() - 1).transpose();
+    }
+  }
+
+  /**
+   * @brief Evaluate the spline at "count" uniformly spaced points "begin" +
+   * i * "step".
+   *
+   * On each polynomial piece the values are generated by forward differencing
+   * the difference table of the piece, which takes "order - 1" additions per
+   * sample. The difference table is re-anchored with exact piece evaluations
+   * every "reanchor" samples and at each knot to limit the accumulation of
+   * rounding errors. Points outside the spline domain are evaluated directly.
+   *
+   * @param begin first evaluation point.
+   * @param step positive distance between evaluation points.
+   * @param count number of evaluation points.
+   * @param reanchor number of samples between re-anchoring.
+   * @return Eigen::ArrayXXd spline values with "count" rows and "dim()"
+   * columns.
+   */
+  Eigen::ArrayXXd sampleUniform(double begin, double step, int count,
+                                int reanchor = 64) const {
+    assert(step > 0.0 && "Step must be positive.");
+    assert(reanchor > 0 && "Re-anchoring interval must be positive.");
+
+    const Eigen::ArrayXd &knots{m_basis->knots()};
+    const int degree{m_basis->order() - 1};
+    const double domainBegin{knots(degree)};
+
+    Eigen::ArrayXXd values(count, dim());
+    int cSample{};
+
+    // points left of the domain
+    while (cSample < count && begin + cSample * step < domainBegin)
+      ++cSample;
+    if (cSample > 0)
+      values.topRows(cSample) = (*this)(
+          Eigen::ArrayXd::LinSpaced(cSample, begin, begin + (cSample - 1) * step));
+
+    // points in the domain, spans are right-closed except the first one
+    Eigen::MatrixXd table(degree + 1, dim());
+    for (int span{degree}; span < m_basis->dim() && cSample < count; ++span) {
+      const double spanBegin{knots(span)};
+      const double spanEnd{knots(span + 1)};
+      if (spanBegin >= spanEnd)
+        continue;
+
+      const Eigen::MatrixXd controlPoints{getBezier(span)};
+      const double spanLength{spanEnd - spanBegin};
+
+      int cAnchor{};
+      for (; cSample < count && begin + cSample * step <= spanEnd;
+           ++cSample, ++cAnchor) {
+        // anchor difference table at current sample
+        if (cAnchor % reanchor == 0) {
+          for (int cRow{}; cRow <= degree; ++cRow)
+            table.row(cRow) =
+                deCasteljau(controlPoints,
+                            (begin + (cSample + cRow) * step - spanBegin) /
+                                spanLength)
+                    .transpose();
+          for (int level{1}; level <= degree; ++level)
+            for (int cRow{degree}; cRow >= level; --cRow)
+              table.row(cRow) -= table.row(cRow - 1);
+        }
+
+        // emit current value and advance the difference table
+        values.row(cSample) = table.row(0).array();
+        for (int cRow{}; cRow < degree; ++cRow)
+          table.row(cRow) += table.row(cRow + 1);
+      }
+    }
+
+    // points right of the domain
+    if (cSample < count)
+      values.bottomRows(count - cSample) = (*this)(Eigen::ArrayXd::LinSpaced(
+          count - cSample, begin + cSample * step, begin + (count - 1) * step));
+
+    return values;
+  }
+
 private:
   // MARK: private properties
 
   std::shared_ptr<Basis> m_basis{}; /**<< spline basis */
   Eigen::MatrixXd m_coefficients{}; /**<< spline coefficients */
+  static inline int s_sortedThreshold{
+      8}; /**<< minimum points for span-sorted evaluation */
+  static constexpr int s_maxOrderInto{
+      32}; /**<< derivative order limit of Spline::derivativeInto reuse */
 
   // MARK: private methods
+  /**
+   * @brief Determine the derivative coefficients of order "orderDer" by the
+   * difference recurrence of Basis::derivative without creating the
+   * intermediate bases.
+   *
+   * @param orderDer derivative order in [1, order).
+   * @return Eigen::MatrixXd derivative coefficients.
+   */
+  Eigen::MatrixXd getDerivativeCoefficients(int orderDer) const {
+    const Eigen::ArrayXd &knots{m_basis->knots()};
+    const int order{m_basis->order()};
+    Eigen::MatrixXd coeffs{};
+    for (int level{}; level < orderDer; ++level) {
+      const Eigen::MatrixXd &coeffsPrev{level == 0 ? m_coefficients : coeffs};
+      // derivative bases following the first have unit scale
+      const double factor{(order - 1 - level) /
+                          (level == 0 ? m_basis->getScale() : 1.0)};
+      Eigen::MatrixXd coeffsNew(coeffsPrev.rows() - 1, coeffsPrev.cols());
+      for (Eigen::Index cCol{}; cCol < coeffsNew.cols(); ++cCol)
+        for (Eigen::Index cRow{}; cRow < coeffsNew.rows(); ++cRow)
+          coeffsNew(cRow, cCol) =
+              factor * (coeffsPrev(cRow + 1, cCol) - coeffsPrev(cRow, cCol)) /
+              (knots(cRow + order) - knots(cRow + level + 1));
+      coeffs = std::move(coeffsNew);
+    }
+    return coeffs;
+  }
+
+  /**
+   * @brief Assign the cached "basis" of a TransformCache transform to "out"
+   * through BasisPool::makeBasis. The basis of "out" is kept without allocation
+   * if it equals "basis".
+   *
+   * @param basis immutable basis of the transform.
+   * @param out spline to assign the basis to.
+   */
+  static void assignCachedBasis(const std::shared_ptr<const Basis> &basis,
+                                Spline &out) {
+    if (!out.m_basis || !(*out.m_basis == *basis))
+      out.m_basis = BasisPool::makeBasis(Basis{*basis});
+  }
+
+  /**
+   * @brief Recursively subdivide the Bezier curve with "controlPoints" on
+   * ["begin", "end"] until its control polygon is flat and pass the end
+   * vertices of the flat parts to "sink".
+   *
+   * @param controlPoints control points of the Bezier curve.
+   * @param begin first point of the curve interval.
+   * @param end last point of the curve interval.
+   * @param tolerance maximum distance between curve and chord.
+   * @param sink receives each vertex as point and spline value.
+   * @param depth remaining number of subdivisions.
+   */
+  static void flattenBezier(
+      const Eigen::MatrixXd &controlPoints, double begin, double end,
+      double tolerance,
+      const std::function<void(double, const Eigen::VectorXd &)> &sink,
+      int depth) {
+    const Eigen::Index degree{controlPoints.rows() - 1};
+
+    // maximum distance of the control points to the chord
+    double distance{};
+    for (Eigen::Index cRow{1}; cRow < degree; ++cRow) {
+      const double param{static_cast<double>(cRow) / degree};
+      distance = std::max(distance,
+                          (controlPoints.row(cRow) -
+                           (1.0 - param) * controlPoints.row(0) -
+                           param * controlPoints.row(degree))
+                              .norm());
+    }
+
+    // base case: chord approximates the curve
+    if (distance <= tolerance || depth <= 0) {
+      sink(end, controlPoints.row(degree).transpose());
+      return;
+    }
+
+    // subdivide at the interval center
+    const auto [pointsL, pointsR] = deCasteljauSplit(controlPoints, 0.5);
+    const double center{0.5 * (begin + end)};
+    flattenBezier(pointsL, begin, center, tolerance, sink, depth - 1);
+    flattenBezier(pointsR, center, end, tolerance, sink, depth - 1);
+  }
+
   /**
    * @brief Interpolates coefficients along each dimension when inserting a new
    * knot.
@@ -386,8 +1172,22 @@ private:
    */
   Eigen::VectorXd interpolateCoefficients(double knotInsert, int dim) const {
     Eigen::VectorXd coeffsNew(m_coefficients.rows() + 1);
-    const Eigen::VectorXd coeffs{m_coefficients(Eigen::all, dim)};
-    const Eigen::ArrayXd knots{m_basis->knots()};
+    interpolateCoefficients(knotInsert, dim, coeffsNew);
+    return coeffsNew;
+  }
+
+  /**
+   * @brief Interpolates coefficients when inserting a new knot and stores
+   * them in "coeffsNew".
+   *
+   * @param knotInsert The position of the knot to be inserted.
+   * @param dim The dimension (column) of the coefficients to be updated.
+   * @param coeffsNew The updated coefficients with one additional element.
+   */
+  void interpolateCoefficients(double knotInsert, int dim,
+                               Eigen::Ref<Eigen::VectorXd> coeffsNew) const {
+    const auto coeffs{m_coefficients.col(dim)};
+    const Eigen::ArrayXd &knots{m_basis->knots()};
     const Eigen::Index order{m_basis->order()};
 
     Eigen::Index knotIdx{};
@@ -411,8 +1211,29 @@ private:
     // case 3: shift coefficients
     for (; knotIdx < coeffsNew.size(); ++knotIdx)
       coeffsNew(knotIdx) = coeffs(knotIdx - 1);
+  }
 
-    return coeffsNew;
+  /**
+   * @brief Determine if the spline basis has unit scale, given "order" and
+   * "numKnots" knots equal to "knot"(idx). Bases derived by Basis::derivative,
+   * Basis::integral and Basis::insertKnots have unit scale.
+   *
+   * @tparam KnotFn type of the knot function.
+   * @param order basis order.
+   * @param numKnots number of knots.
+   * @param knot expected knot at index.
+   * @return true spline basis has the given structure.
+   * @return false spline basis differs.
+   */
+  template <typename KnotFn>
+  bool hasBasis(int order, Eigen::Index numKnots, const KnotFn &knot) const {
+    if (!m_basis || m_basis->order() != order || m_basis->getScale() != 1.0 ||
+        m_basis->knots().size() != numKnots)
+      return false;
+    for (Eigen::Index idx{}; idx < numKnots; ++idx)
+      if (m_basis->knots()(idx) != knot(idx))
+        return false;
+    return true;
   }
 
   /**
@@ -434,7 +1255,8 @@ private:
    * @param dim Output dimension to evaluate.
    * @param maxIter Maximum number of iterations.
    * @param accAbs Tolerance for the spline output to be considered zero.
-   * @return double Root estimates along the given output dimension.
+   * @return double Root estimates along the given output dimension, NaN if the
+   * sign change of the coefficient pair vanishes during refinement.
    */
   double estimateRoot(int rootIdx, int dim, int maxIter, double accAbs) const {
     Spline inserted{*this};
@@ -464,9 +1286,14 @@ private:
         coeffs = inserted.getCoefficients()(Eigen::all, dim);
 
         // after insertion, check if zero moved between new greville and former
-        // right greville
-        if (coeffs(rootIdx + 1) * coeffs(rootIdx + 2) <= 0)
+        // right greville, no root if the sign change vanished
+        const auto hasSignChange{[&coeffs](int idx) {
+          return idx + 1 < coeffs.size() && coeffs(idx) * coeffs(idx + 1) <= 0;
+        }};
+        if (hasSignChange(rootIdx + 1))
           rootIdx += 1;
+        else if (!hasSignChange(rootIdx))
+          return std::numeric_limits<double>::quiet_NaN();
       }
     }
 
@@ -535,6 +1362,22 @@ private:
     return abs((*this)({{value}})(0, dim)) <= absTol;
   }
 };
+
+#ifdef BASIS_SPLINES_COMPILED
+// instantiated in the compiled library, see src/basisSplines.cpp
+extern template Spline Spline::add<Interpolate>(const Spline &, double,
+                                                double) const;
+extern template void Spline::addInto<Interpolate>(const Spline &, Spline &,
+                                                  double, double) const;
+extern template Spline Spline::prod<Interpolate>(const Spline &, double,
+                                                 double) const;
+extern template void Spline::prodInto<Interpolate>(const Spline &, Spline &,
+                                                   double, double) const;
+extern template Spline Spline::compose<Interpolate>(const Spline &, double,
+                                                    double) const;
+extern template Spline Spline::orderElevation<Interpolate>(int) const;
+extern template Spline Spline::getClamped<Interpolate>() const;
+#endif
 }; // namespace BasisSplines
 
 #endif
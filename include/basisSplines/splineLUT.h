@@ -0,0 +1,254 @@
+#ifndef SPLINE_LUT_H
+#define SPLINE_LUT_H
+
+#include <Eigen/Core>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "basisSplines/spline.h"
+
+namespace BasisSplines {
+
+/**
+ * @brief Lookup table approximating a spline on a uniform grid.
+ *
+ * The spline is interpolated on each grid interval by a linear or a cubic
+ * Hermite polynomial. The grid step is chosen such that the interpolation
+ * error is below a given tolerance. The error bound follows from the maximum
+ * absolute derivative, which is bounded by the maximum absolute coefficient of
+ * the derivative spline [Boo01, B-spline prop. (v)].
+ *
+ * The polynomials are stored in power form of the local parameter in [0, 1].
+ * The coefficients of each output dimension are contiguous with the
+ * coefficients of an interval being adjacent.
+ */
+class SplineLUT {
+public:
+  // MARK: public methods
+  SplineLUT() = default;
+
+  /**
+   * @brief Construct the lookup table of the "spline" with interpolation error
+   * less than "tolerance" on the spline domain.
+   *
+   * The error bound requires the derivative of order 2 for linear and of order
+   * 4 for cubic Hermite interpolation to be bounded. For splines of lower
+   * continuity, the bound for the highest bounded derivative is used. Throws
+   * std::invalid_argument for discontinuous splines or if more than
+   * "maxIntervals" intervals are required.
+   *
+   * @param spline spline to approximate.
+   * @param tolerance maximum interpolation error.
+   * @param cubic use cubic Hermite instead of linear interpolation.
+   * @param maxIntervals maximum number of grid intervals.
+   */
+  SplineLUT(const Spline &spline, double tolerance, bool cubic = false,
+            int maxIntervals = 1 << 22)
+      : m_numCoeffs{cubic ? 4 : 2}, m_dim{spline.dim()} {
+    assert(tolerance > 0.0 && "Tolerance must be positive.");
+
+    const std::shared_ptr<Basis> basis{spline.basis()};
+    m_begin = basis->knots()(basis->order() - 1);
+    m_end = basis->knots()(basis->dim());
+
+    // highest bounded derivative from the interior continuity, where
+    // continuity c corresponds with c - 1 continuous derivatives
+    const auto [breakpoints, continuities] = basis->getBreakpoints();
+    int orderDer{cubic ? 4 : 2};
+    if (continuities.size() > 2)
+      orderDer = std::min(
+          orderDer,
+          continuities.segment(1, continuities.size() - 2).minCoeff());
+    if (orderDer < 1)
+      throw std::invalid_argument("Lookup table requires a continuous spline.");
+
+    // grid step from the error bound of the interpolation
+    const double length{m_end - m_begin};
+    const double bound{getDerivBound(spline, orderDer)};
+    const double factor{getErrorFactor(orderDer, cubic)};
+    int numIntervals{1};
+    if (bound * factor > 0.0) {
+      const double step{
+          std::pow(tolerance / (factor * bound), 1.0 / orderDer)};
+      const double numRequired{std::ceil(length / step)};
+      if (numRequired > maxIntervals)
+        throw std::invalid_argument(
+            "Lookup table requires more than maxIntervals intervals.");
+      numIntervals = std::max(static_cast<int>(numRequired), 1);
+    }
+    m_numIntervals = numIntervals;
+    m_invStep = numIntervals / length;
+    m_errorBound = factor * bound * std::pow(length / numIntervals, orderDer);
+
+    // spline values at grid points
+    const Eigen::ArrayXd points{
+        Eigen::ArrayXd::LinSpaced(numIntervals + 1, m_begin, m_end)};
+    const Eigen::ArrayXXd values{spline(points)};
+    Eigen::ArrayXXd derivs{};
+    if (cubic)
+      derivs = spline.derivative()(points) * basis->getScale() *
+               (length / numIntervals);
+
+    // power coefficients of the interval polynomials
+    m_table.resize(static_cast<size_t>(m_dim) * numIntervals * m_numCoeffs);
+    for (int cDim{}; cDim < m_dim; ++cDim) {
+      double *coeffs{&m_table[static_cast<size_t>(cDim) * numIntervals *
+                              m_numCoeffs]};
+      for (int cInt{}; cInt < numIntervals; ++cInt, coeffs += m_numCoeffs) {
+        const double valueL{values(cInt, cDim)};
+        const double valueR{values(cInt + 1, cDim)};
+        coeffs[0] = valueL;
+        if (!cubic) {
+          coeffs[1] = valueR - valueL;
+          continue;
+        }
+
+        const double derivL{derivs(cInt, cDim)};
+        const double derivR{derivs(cInt + 1, cDim)};
+        coeffs[1] = derivL;
+        coeffs[2] = 3.0 * (valueR - valueL) - 2.0 * derivL - derivR;
+        coeffs[3] = 2.0 * (valueL - valueR) + derivL + derivR;
+      }
+    }
+  }
+
+  /**
+   * @brief Evaluate the lookup table at "point" for the output dimension
+   * "dim". Points outside the spline domain are clamped to the domain.
+   *
+   * @param point evaluation point.
+   * @param dim output dimension.
+   * @return double approximate spline value.
+   */
+  double operator()(double point, int dim = 0) const {
+    // interval index and local parameter
+    const double param{
+        std::clamp((point - m_begin) * m_invStep, 0.0,
+                   static_cast<double>(m_numIntervals))};
+    const int interval{std::min(static_cast<int>(param), m_numIntervals - 1)};
+    const double local{param - interval};
+
+    const double *coeffs{
+        &m_table[(static_cast<size_t>(dim) * m_numIntervals + interval) *
+                 m_numCoeffs]};
+    if (m_numCoeffs == 2)
+      return coeffs[0] + local * coeffs[1];
+    return coeffs[0] +
+           local * (coeffs[1] + local * (coeffs[2] + local * coeffs[3]));
+  }
+
+  /**
+   * @brief Evaluate the lookup table at given "points".
+   *
+   * @param points evaluation points.
+   * @return Eigen::ArrayXXd approximate spline values with "points.size()"
+   * rows and "dim()" columns.
+   */
+  Eigen::ArrayXXd operator()(const Eigen::ArrayXd &points) const {
+    Eigen::ArrayXXd values(points.size(), m_dim);
+    for (int cDim{}; cDim < m_dim; ++cDim)
+      for (Eigen::Index cPoint{}; cPoint < points.size(); ++cPoint)
+        values(cPoint, cDim) = (*this)(points(cPoint), cDim);
+    return values;
+  }
+
+  /**
+   * @brief Get the bound of the interpolation error.
+   *
+   * @return double maximum interpolation error.
+   */
+  double getErrorBound() const { return m_errorBound; }
+
+  /**
+   * @brief Get the number of grid intervals.
+   *
+   * @return int number of grid intervals.
+   */
+  int getNumIntervals() const { return m_numIntervals; }
+
+  /**
+   * @brief Get the first point of the spline domain.
+   *
+   * @return double first point of the lookup table.
+   */
+  double begin() const { return m_begin; }
+
+  /**
+   * @brief Get the last point of the spline domain.
+   *
+   * @return double last point of the lookup table.
+   */
+  double end() const { return m_end; }
+
+  /**
+   * @brief Get the output dimensionality.
+   *
+   * @return int output dimensionality.
+   */
+  int dim() const { return m_dim; }
+
+private:
+  // MARK: private properties
+
+  std::vector<double> m_table{}; /**<< interval polynomial coefficients */
+  double m_begin{};              /**<< first point of the domain */
+  double m_end{};                /**<< last point of the domain */
+  double m_invStep{};            /**<< inverse grid step */
+  double m_errorBound{};         /**<< bound of the interpolation error */
+  int m_numIntervals{};          /**<< number of grid intervals */
+  int m_numCoeffs{};             /**<< coefficients per interval */
+  int m_dim{};                   /**<< output dimensionality */
+
+  // MARK: private methods
+
+  /**
+   * @brief Bound the derivative of order "orderDer" of the "spline" with
+   * respect to the knots by the maximum absolute derivative coefficient.
+   * Spline::derivative divides by the basis scale once for any order, since
+   * the derivative bases following the first have unit scale.
+   *
+   * @param spline spline to bound.
+   * @param orderDer derivative order.
+   * @return double maximum absolute derivative.
+   */
+  static double getDerivBound(const Spline &spline, int orderDer) {
+    if (orderDer >= spline.basis()->order())
+      return 0.0;
+    return spline.derivative(orderDer).getCoefficients().cwiseAbs().maxCoeff() *
+           spline.basis()->getScale();
+  }
+
+  /**
+   * @brief Get the factor c of the interpolation error bound c h^k M_k for the
+   * grid step h and the maximum absolute derivative M_k of order k.
+   *
+   * The factors for linear interpolation with k = 2 and cubic Hermite
+   * interpolation with k = 4 are the classical bounds 1 / 8 and 1 / 384. The
+   * remaining factors follow from comparing with the Taylor polynomial at the
+   * interval center, whose interpolation error vanishes.
+   *
+   * @param orderDer derivative order k.
+   * @param cubic cubic Hermite instead of linear interpolation.
+   * @return double error bound factor.
+   */
+  static double getErrorFactor(int orderDer, bool cubic) {
+    if (!cubic)
+      return orderDer == 2 ? 1.0 / 8.0 : 1.0 / 2.0;
+
+    switch (orderDer) {
+    case 4:
+      return 1.0 / 384.0;
+    case 3:
+      return 7.0 / 96.0;
+    case 2:
+      return 3.0 / 8.0;
+    default:
+      return 5.0 / 4.0;
+    }
+  }
+};
+}; // namespace BasisSplines
+
+#endif
@@ -0,0 +1,293 @@
+#ifndef SPLINE_STATS_H
+#define SPLINE_STATS_H
+
+#include <Eigen/Core>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "basisSplines/executor.h"
+#include "basisSplines/spline.h"
+
+namespace BasisSplines {
+
+/**
+ * @brief Closed-form statistics of a spline over windows of its domain.
+ *
+ * The antiderivatives of the spline and of its square are determined once on
+ * construction. The square is the spline product of the spline with itself.
+ * The integral over a window is the difference of the antiderivative at the
+ * window limits, such that each window is answered by two span searches in
+ * O(log n) and two local evaluations independent of the window length.
+ *
+ * Windows are given by their first and last points, which must lie in the
+ * spline domain ["knots(order - 1)", "knots(dim)"]. The statistics are
+ * returned with one row per window and one column per output dimension.
+ *
+ * Window limits are in knot units. As for Spline::integral, integrals and
+ * durations are in units of the knots multiplied by the basis scale, such that
+ * a window's length is "scale * (end - begin)".
+ */
+class SplineStats {
+public:
+  // MARK: public methods
+
+  /**
+   * @brief Construct the statistics of the given "spline".
+   *
+   * @param spline spline to determine the statistics of.
+   * @param accScale accepted difference between the basis scalings of the
+   * squared spline.
+   * @param accBps tolerance for assigning knots to breakpoint.
+   */
+  explicit SplineStats(const Spline &spline, double accScale = 1e-6,
+                       double accBps = 1e-6)
+      : m_spline{spline}, m_integral{spline.integral()},
+        m_integralSq{spline.prod(spline, accScale, accBps).integral()} {
+    const Basis &basis{*spline.basis()};
+    m_begin = basis.knots()(basis.order() - 1);
+    m_end = basis.knots()(basis.dim());
+    m_scale = basis.getScale();
+  }
+
+  /**
+   * @brief Determine the integral of the spline over each window.
+   *
+   * @param begins first points of the windows.
+   * @param ends last points of the windows.
+   * @return Eigen::ArrayXXd integrals over the windows.
+   */
+  Eigen::ArrayXXd integral(const Eigen::ArrayXd &begins,
+                           const Eigen::ArrayXd &ends) const {
+    checkWindows(begins, ends);
+    return evalLocal(m_integral, ends) - evalLocal(m_integral, begins);
+  }
+
+  /**
+   * @brief Determine the mean of the spline over each window.
+   *
+   * @param begins first points of the windows.
+   * @param ends last points of the windows.
+   * @return Eigen::ArrayXXd means over the windows.
+   */
+  Eigen::ArrayXXd mean(const Eigen::ArrayXd &begins,
+                       const Eigen::ArrayXd &ends) const {
+    return integral(begins, ends).colwise() / windowLengths(begins, ends);
+  }
+
+  /**
+   * @brief Determine the mean of the squared spline over each window.
+   *
+   * @param begins first points of the windows.
+   * @param ends last points of the windows.
+   * @return Eigen::ArrayXXd means of the squared spline over the windows.
+   */
+  Eigen::ArrayXXd meanSquare(const Eigen::ArrayXd &begins,
+                             const Eigen::ArrayXd &ends) const {
+    checkWindows(begins, ends);
+    return (evalLocal(m_integralSq, ends) - evalLocal(m_integralSq, begins))
+               .colwise() /
+           windowLengths(begins, ends);
+  }
+
+  /**
+   * @brief Determine the variance of the spline over each window as the mean
+   * square minus the squared mean. Negative values due to round-off are set
+   * to zero.
+   *
+   * @param begins first points of the windows.
+   * @param ends last points of the windows.
+   * @return Eigen::ArrayXXd variances over the windows.
+   */
+  Eigen::ArrayXXd variance(const Eigen::ArrayXd &begins,
+                           const Eigen::ArrayXd &ends) const {
+    return (meanSquare(begins, ends) - mean(begins, ends).square()).max(0.0);
+  }
+
+  /**
+   * @brief Determine the root mean square of the spline over each window.
+   *
+   * @param begins first points of the windows.
+   * @param ends last points of the windows.
+   * @return Eigen::ArrayXXd root mean squares over the windows.
+   */
+  Eigen::ArrayXXd rms(const Eigen::ArrayXd &begins,
+                      const Eigen::ArrayXd &ends) const {
+    return meanSquare(begins, ends).max(0.0).sqrt();
+  }
+
+  /**
+   * @brief Determine the time the spline exceeds the "threshold" in each
+   * window.
+   *
+   * The crossings of the threshold are the roots of the spline shifted by the
+   * threshold, see Spline::getRoots. They partition the domain into intervals
+   * on which the spline is either above or below the threshold. The
+   * cumulative time above the threshold at the crossings is shared by all
+   * windows, which are answered by binary searches on the crossings. The
+   * durations are scaled by the basis scale like the window lengths.
+   *
+   * @param threshold value to exceed.
+   * @param begins first points of the windows.
+   * @param ends last points of the windows.
+   * @param maxIter Maximum number of iterations of the root estimation.
+   * @param accAbs Tolerance for the shifted spline to be considered zero.
+   * @return Eigen::ArrayXXd durations above the threshold in the windows.
+   */
+  Eigen::ArrayXXd timeAbove(double threshold, const Eigen::ArrayXd &begins,
+                            const Eigen::ArrayXd &ends, int maxIter = 10,
+                            double accAbs = 1e-6) const {
+    checkWindows(begins, ends);
+
+    // coefficients shifted by the threshold shift the spline on its domain
+    const Spline shifted{
+        m_spline.basis(),
+        Eigen::MatrixXd{m_spline.getCoefficients().array() - threshold}};
+
+    Eigen::ArrayXXd durations(begins.size(), dim());
+    for (int cDim{}; cDim < dim(); ++cDim) {
+      // crossings limited to the domain bound the intervals of constant sign
+      const Eigen::ArrayXd roots{shifted.getRoots(cDim, maxIter, accAbs)};
+      std::vector<double> bounds{m_begin};
+      for (const double root : roots)
+        if (root > m_begin && root < m_end)
+          bounds.push_back(root);
+      bounds.push_back(m_end);
+      std::sort(bounds.begin(), bounds.end());
+      bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end());
+
+      // interval is above the threshold if its midpoint is
+      const Eigen::Index numIntervals{
+          static_cast<Eigen::Index>(bounds.size()) - 1};
+      Eigen::ArrayXd centers(numIntervals);
+      for (Eigen::Index cInt{}; cInt < numIntervals; ++cInt)
+        centers(cInt) = 0.5 * (bounds[cInt] + bounds[cInt + 1]);
+      const Eigen::ArrayXd valuesCenter{
+          evalLocal(shifted, centers).col(cDim)};
+
+      // cumulative time above the threshold at the interval bounds
+      std::vector<double> cumulative(bounds.size());
+      for (Eigen::Index cInt{}; cInt < numIntervals; ++cInt)
+        cumulative[cInt + 1] =
+            cumulative[cInt] + (valuesCenter(cInt) > 0.0
+                                    ? bounds[cInt + 1] - bounds[cInt]
+                                    : 0.0);
+
+      const auto timeAboveAt{[&](double point) {
+        const Eigen::Index cInt{std::clamp<Eigen::Index>(
+            std::upper_bound(bounds.begin(), bounds.end(), point) -
+                bounds.begin() - 1,
+            0, numIntervals - 1)};
+        return cumulative[cInt] +
+               (valuesCenter(cInt) > 0.0 ? point - bounds[cInt] : 0.0);
+      }};
+
+      for (Eigen::Index cWin{}; cWin < begins.size(); ++cWin)
+        durations(cWin, cDim) =
+            m_scale * (timeAboveAt(ends(cWin)) - timeAboveAt(begins(cWin)));
+    }
+
+    return durations;
+  }
+
+  /**
+   * @brief Get the first point of the spline domain.
+   *
+   * @return double first point of the domain.
+   */
+  double begin() const { return m_begin; }
+
+  /**
+   * @brief Get the last point of the spline domain.
+   *
+   * @return double last point of the domain.
+   */
+  double end() const { return m_end; }
+
+  /**
+   * @brief Get the output dimensionality.
+   *
+   * @return int output dimensionality.
+   */
+  int dim() const { return m_spline.dim(); }
+
+private:
+  // MARK: private properties
+
+  Spline m_spline;     /**<< spline of the statistics */
+  Spline m_integral;   /**<< antiderivative of the spline */
+  Spline m_integralSq; /**<< antiderivative of the squared spline */
+  double m_begin{};    /**<< first point of the domain */
+  double m_end{};      /**<< last point of the domain */
+  double m_scale{};    /**<< scale of the spline basis */
+
+  // MARK: private methods
+
+  /**
+   * @brief Throw std::invalid_argument if the windows are not of positive
+   * length or exceed the spline domain.
+   *
+   * @param begins first points of the windows.
+   * @param ends last points of the windows.
+   */
+  void checkWindows(const Eigen::ArrayXd &begins,
+                    const Eigen::ArrayXd &ends) const {
+    if (begins.size() != ends.size())
+      throw std::invalid_argument(
+          "Number of window begins and ends must be equal.");
+    if ((begins >= ends).any())
+      throw std::invalid_argument("Windows must be of positive length.");
+    if (begins.size() > 0 && (begins.minCoeff() < m_begin ||
+                              ends.maxCoeff() > m_end))
+      throw std::invalid_argument("Windows exceed the spline domain.");
+  }
+
+  /**
+   * @brief Determine the lengths of the windows scaled by the basis scale.
+   *
+   * @param begins first points of the windows.
+   * @param ends last points of the windows.
+   * @return Eigen::ArrayXd scaled window lengths.
+   */
+  Eigen::ArrayXd windowLengths(const Eigen::ArrayXd &begins,
+                               const Eigen::ArrayXd &ends) const {
+    return m_scale * (ends - begins);
+  }
+
+  /**
+   * @brief Evaluate "spline" at each of the "points" with the basis functions
+   * non-zero on the point's span, see Basis::evalSpan.
+   *
+   * @param spline spline to evaluate.
+   * @param points evaluation points in the knot range.
+   * @return Eigen::ArrayXXd spline values at "points".
+   */
+  static Eigen::ArrayXXd evalLocal(const Spline &spline,
+                                   const Eigen::ArrayXd &points) {
+    const Basis &basis{*spline.basis()};
+    const Eigen::MatrixXd &coeffs{spline.getCoefficients()};
+    const int order{basis.order()};
+    Eigen::ArrayXXd values{Eigen::ArrayXXd::Zero(points.size(), spline.dim())};
+
+    Executor::parallelFor(
+        0, points.size(), [&](Eigen::Index begin, Eigen::Index end) {
+          Eigen::VectorXd basisValues(order);
+          for (Eigen::Index cPoint{begin}; cPoint < end; ++cPoint) {
+            const int span{basis.getSpan(points(cPoint))};
+            basis.evalSpan(points(cPoint), span, basisValues);
+            for (int cValue{}; cValue < order; ++cValue) {
+              const int idx{span - order + 1 + cValue};
+              if (idx >= 0 && idx < coeffs.rows())
+                values.row(cPoint) +=
+                    basisValues(cValue) * coeffs.row(idx).array();
+            }
+          }
+        });
+
+    return values;
+  }
+};
+}; // namespace BasisSplines
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef SPLINE_WORKSPACE_H
+#define SPLINE_WORKSPACE_H
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace BasisSplines {
+
+/**
+ * @brief Scoped arena for temporary buffers of spline operations.
+ *
+ * While a workspace exists, spline operations on the same thread draw their
+ * scratch buffers from a monotonic buffer resource instead of the heap. The
+ * memory is released at once when the workspace is destroyed. Workspaces may
+ * be nested, in which case the innermost workspace is used.
+ *
+ * Results of operations, e.g. coefficient matrices and bases, are always
+ * allocated on the heap, since Eigen dense objects do not support custom
+ * allocators and results may outlive the workspace.
+ */
+class SplineWorkspace {
+public:
+  // MARK: public methods
+
+  /**
+   * @brief Construct a new workspace for the current thread with an initial
+   * arena of "initialSize" bytes.
+   *
+   * @param initialSize initial arena size in bytes.
+   */
+  explicit SplineWorkspace(size_t initialSize = 1 << 16)
+      : m_arena{initialSize}, m_previous{s_current} {
+    s_current = this;
+  }
+
+  SplineWorkspace(const SplineWorkspace &) = delete;
+  SplineWorkspace &operator=(const SplineWorkspace &) = delete;
+
+  /**
+   * @brief Destroy the workspace, release its memory and restore the
+   * enclosing workspace.
+   *
+   */
+  ~SplineWorkspace() { s_current = m_previous; }
+
+  /**
+   * @brief Get the memory resource for scratch buffers on the current
+   * thread. This is the arena of the innermost workspace or the default
+   * resource without workspace.
+   *
+   * @return std::pmr::memory_resource* memory resource for scratch buffers.
+   */
+  static std::pmr::memory_resource *resource() {
+    return s_current ? &s_current->m_arena : std::pmr::get_default_resource();
+  }
+
+private:
+  // MARK: private properties
+
+  static inline thread_local SplineWorkspace *s_current{
+      nullptr}; /**<< innermost workspace of the thread */
+
+  std::pmr::monotonic_buffer_resource m_arena; /**<< scratch memory */
+  SplineWorkspace *m_previous{};               /**<< enclosing workspace */
+};
+}; // namespace BasisSplines
+
+#endif
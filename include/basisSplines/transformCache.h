@@ -0,0 +1,437 @@
+#ifndef TRANSFORM_CACHE_H
+#define TRANSFORM_CACHE_H
+
+#include <Eigen/Core>
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+#include "basisSplines/basis.h"
+#include "basisSplines/interpolate.h"
+
+namespace BasisSplines {
+
+/**
+ * @brief Least recently used cache of bases and coefficient transformations
+ * resulting from Basis::add, Basis::prod and Basis::derivative.
+ *
+ * The transformations only depend on the operand bases and the operation
+ * parameters. Repeated sums and products on the same bases are reduced to a
+ * multiplication of the cached transformation matrices with the spline
+ * coefficients. Derivatives only cache their basis, since the difference
+ * recurrence of the coefficients is cheaper than a product with the dense
+ * transformation matrix. The global cache is disabled with capacity zero by
+ * default. Besides the number of entries, the memory of the cached bases and
+ * matrices is limited to TransformCache::getMaxBytes.
+ *
+ * The resulting bases are immutable and owned by the cache. Spline operations
+ * assign copies of them to their results, such that modifying the basis of a
+ * result does not affect the cached transforms.
+ */
+class TransformCache {
+public:
+  /**
+   * @brief Resulting basis and coefficient transformations of an operation.
+   *
+   */
+  struct Transform {
+    std::shared_ptr<const Basis> basis{};    /**<< resulting basis */
+    std::vector<Eigen::MatrixXd> matrices{}; /**<< transformation matrices */
+  };
+
+  static constexpr size_t defaultMaxBytes{
+      size_t{64} << 20}; /**<< default memory limit of 64 MiB */
+
+  // MARK: public methods
+
+  /**
+   * @brief Construct a new transform cache holding "capacity" transforms with
+   * at most "maxBytes" bytes.
+   *
+   * @param capacity maximum number of cached transforms.
+   * @param maxBytes maximum memory of the cached transforms.
+   */
+  TransformCache(size_t capacity = 0, size_t maxBytes = defaultMaxBytes)
+      : m_capacity{capacity}, m_maxBytes{maxBytes} {}
+
+  /**
+   * @brief Get the global transform cache used by spline operations.
+   *
+   * @return TransformCache& global cache.
+   */
+  static TransformCache &global() {
+    static TransformCache cache{};
+    return cache;
+  }
+
+  /**
+   * @brief Get the transforms of Basis::add for the bases "basisL" and
+   * "basisR".
+   *
+   * @tparam Interp type of interpolation.
+   * @param basisL left operand basis.
+   * @param basisR right operand basis.
+   * @param accScale accepted difference between operand basis scaling.
+   * @param accBps tolerance for assigning knots to breakpoint.
+   * @return std::shared_ptr<const Transform> sum basis and transforms Tl, Tr.
+   */
+  template <typename Interp = Interpolate>
+  std::shared_ptr<const Transform> add(const Basis &basisL,
+                                       const Basis &basisR,
+                                       double accScale = 1e-6,
+                                       double accBps = 1e-6) {
+    return get(opAdd, typeid(Interp).hash_code(), {&basisL, &basisR},
+               {accScale, accBps}, [&]() {
+                 Basis basisOut{};
+                 auto [transformL, transformR] = basisL.add<Interp>(
+                     basisR, basisOut, accScale, accBps);
+                 return Transform{
+                     std::make_shared<const Basis>(std::move(basisOut)),
+                     {std::move(transformL), std::move(transformR)}};
+               });
+  }
+
+  /**
+   * @brief Get the transform of Basis::prod for the bases "basisL" and
+   * "basisR".
+   *
+   * @tparam Interp type of interpolation.
+   * @param basisL left operand basis.
+   * @param basisR right operand basis.
+   * @param accScale accepted difference between operand basis scaling.
+   * @param accBps tolerance for assigning knots to breakpoint.
+   * @return std::shared_ptr<const Transform> product basis and transform T.
+   */
+  template <typename Interp = Interpolate>
+  std::shared_ptr<const Transform> prod(const Basis &basisL,
+                                        const Basis &basisR,
+                                        double accScale = 1e-6,
+                                        double accBps = 1e-6) {
+    return get(opProd, typeid(Interp).hash_code(), {&basisL, &basisR},
+               {accScale, accBps}, [&]() {
+                 Basis basisOut{};
+                 Eigen::MatrixXd transform{basisL.prod<Interp>(
+                     basisR, basisOut, accScale, accBps)};
+                 return Transform{
+                     std::make_shared<const Basis>(std::move(basisOut)),
+                     {std::move(transform)}};
+               });
+  }
+
+  /**
+   * @brief Get the basis of Basis::derivative for the "basis". The transform
+   * contains no matrix, the coefficients are determined by the difference
+   * recurrence, see Spline::derivative.
+   *
+   * @param basis basis to differentiate.
+   * @param orderDer derivative order.
+   * @return std::shared_ptr<const Transform> derivative basis.
+   */
+  std::shared_ptr<const Transform> derivative(const Basis &basis,
+                                              int orderDer = 1) {
+    return get(opDerivative, 0, {&basis}, {static_cast<double>(orderDer)},
+               [&]() {
+                 // derivative bases have unit scale, see Basis::derivative
+                 return Transform{std::make_shared<const Basis>(
+                                      orderDer == 0
+                                          ? basis
+                                          : basis.orderDecrease(orderDer)),
+                                  {}};
+               });
+  }
+
+  /**
+   * @brief Set the maximum number of cached transforms. Least recently used
+   * transforms exceeding the capacity are removed. Capacity zero disables the
+   * cache.
+   *
+   * @param capacity maximum number of cached transforms.
+   */
+  void setCapacity(size_t capacity) {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_capacity = capacity;
+    evict();
+  }
+
+  /**
+   * @brief Get the maximum number of cached transforms.
+   *
+   * @return size_t maximum number of cached transforms.
+   */
+  size_t getCapacity() const { return m_capacity; }
+
+  /**
+   * @brief Set the maximum memory of the cached transforms. Least recently used
+   * transforms exceeding the memory are removed and transforms larger than the
+   * memory are not cached.
+   *
+   * @param maxBytes maximum memory of the cached transforms in bytes.
+   */
+  void setMaxBytes(size_t maxBytes) {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_maxBytes = maxBytes;
+    evict();
+  }
+
+  /**
+   * @brief Get the maximum memory of the cached transforms.
+   *
+   * @return size_t maximum memory of the cached transforms in bytes.
+   */
+  size_t getMaxBytes() const { return m_maxBytes; }
+
+  /**
+   * @brief Get the memory of the cached transforms, i.e. of their operand and
+   * resulting bases and transformation matrices.
+   *
+   * @return size_t memory of the cached transforms in bytes.
+   */
+  size_t getBytes() const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return m_bytes;
+  }
+
+  /**
+   * @brief Determine if the cache is enabled by a positive capacity.
+   *
+   * @return true transforms are cached.
+   * @return false transforms are not cached.
+   */
+  bool isEnabled() const { return m_capacity > 0; }
+
+  /**
+   * @brief Get the number of cached transforms.
+   *
+   * @return size_t number of cached transforms.
+   */
+  size_t size() const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return m_entries.size();
+  }
+
+  /**
+   * @brief Get the number of requests answered from the cache.
+   *
+   * @return size_t number of cache hits.
+   */
+  size_t getHits() const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return m_hits;
+  }
+
+  /**
+   * @brief Get the number of requests requiring a computation.
+   *
+   * @return size_t number of cache misses.
+   */
+  size_t getMisses() const {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    return m_misses;
+  }
+
+  /**
+   * @brief Remove all transforms and reset the statistics.
+   *
+   */
+  void clear() {
+    std::lock_guard<std::mutex> lock{m_mutex};
+    m_entries.clear();
+    m_index.clear();
+    m_bytes = 0;
+    m_hits = 0;
+    m_misses = 0;
+  }
+
+private:
+  /**
+   * @brief Identification of an operation by its type, operand bases and
+   * parameters.
+   *
+   */
+  struct Key {
+    int operation{};                  /**<< operation type */
+    size_t interp{};                  /**<< interpolation type hash */
+    std::vector<Basis> operands{};    /**<< operand bases */
+    std::vector<double> parameters{}; /**<< operation parameters */
+    size_t hash{};                    /**<< hash of the identification */
+    size_t bytes{};                   /**<< memory of the entry */
+  };
+
+  using Entry = std::pair<Key, std::shared_ptr<const Transform>>;
+
+  // MARK: private properties
+
+  static constexpr int opAdd{};         /**<< Basis::add operation */
+  static constexpr int opProd{1};       /**<< Basis::prod operation */
+  static constexpr int opDerivative{2}; /**<< Basis::derivative operation */
+
+  mutable std::mutex m_mutex{};     /**<< guards entries and statistics */
+  std::atomic<size_t> m_capacity{}; /**<< maximum number of entries */
+  std::atomic<size_t> m_maxBytes{}; /**<< maximum memory of the entries */
+  size_t m_bytes{};                 /**<< memory of the entries */
+  size_t m_hits{};                  /**<< number of cache hits */
+  size_t m_misses{};                /**<< number of cache misses */
+  std::list<Entry> m_entries{}; /**<< entries from most to least recent */
+  std::unordered_multimap<size_t, std::list<Entry>::iterator>
+      m_index{}; /**<< entries by key hash */
+
+  // MARK: private methods
+
+  /**
+   * @brief Get the transform of an operation from the cache or by "compute".
+   * The operands are only copied into the cache on a miss, such that a hit
+   * requires no allocation. The computation is performed without holding the
+   * lock.
+   *
+   * @tparam Compute type of the transform computation.
+   * @param operation operation type.
+   * @param interp interpolation type hash.
+   * @param operands operand bases.
+   * @param parameters operation parameters.
+   * @param compute computes the transform on a cache miss.
+   * @return std::shared_ptr<const Transform> transform of the operation.
+   */
+  template <typename Compute>
+  std::shared_ptr<const Transform>
+  get(int operation, size_t interp,
+      std::initializer_list<const Basis *> operands,
+      std::initializer_list<double> parameters, const Compute &compute) {
+    const size_t hash{getHash(operation, interp, operands, parameters)};
+    {
+      std::lock_guard<std::mutex> lock{m_mutex};
+      auto entry{find(operation, interp, operands, parameters, hash)};
+      if (entry != m_entries.end()) {
+        ++m_hits;
+        m_entries.splice(m_entries.begin(), m_entries, entry);
+        return entry->second;
+      }
+      ++m_misses;
+    }
+
+    auto transform{std::make_shared<const Transform>(compute())};
+
+    size_t bytes{getBasisBytes(*transform->basis)};
+    for (const Eigen::MatrixXd &matrix : transform->matrices)
+      bytes += matrix.size() * sizeof(double);
+    for (const Basis *operand : operands)
+      bytes += getBasisBytes(*operand);
+
+    std::lock_guard<std::mutex> lock{m_mutex};
+    if (m_capacity == 0 || bytes > m_maxBytes ||
+        find(operation, interp, operands, parameters, hash) != m_entries.end())
+      return transform;
+
+    Key key{operation, interp, {}, parameters, hash, bytes};
+    for (const Basis *operand : operands)
+      key.operands.push_back(*operand);
+    m_entries.emplace_front(std::move(key), transform);
+    m_index.emplace(hash, m_entries.begin());
+    m_bytes += bytes;
+    evict();
+    return transform;
+  }
+
+  /**
+   * @brief Find the entry of an operation.
+   *
+   * @param operation operation type.
+   * @param interp interpolation type hash.
+   * @param operands operand bases.
+   * @param parameters operation parameters.
+   * @param hash hash of the operation.
+   * @return std::list<Entry>::iterator entry or end of entries.
+   */
+  std::list<Entry>::iterator
+  find(int operation, size_t interp,
+       std::initializer_list<const Basis *> operands,
+       std::initializer_list<double> parameters, size_t hash) {
+    auto [index, end] = m_index.equal_range(hash);
+    for (; index != end; ++index) {
+      const Key &key{index->second->first};
+      if (key.operation != operation || key.interp != interp ||
+          !std::equal(key.parameters.begin(), key.parameters.end(),
+                      parameters.begin(), parameters.end()) ||
+          key.operands.size() != operands.size())
+        continue;
+      if (std::equal(key.operands.begin(), key.operands.end(),
+                     operands.begin(),
+                     [](const Basis &basisL, const Basis *basisR) {
+                       return basisL == *basisR;
+                     }))
+        return index->second;
+    }
+    return m_entries.end();
+  }
+
+  /**
+   * @brief Remove least recently used entries exceeding the capacity or the
+   * maximum memory.
+   *
+   */
+  void evict() {
+    while (m_entries.size() > m_capacity || m_bytes > m_maxBytes) {
+      auto [index, end] = m_index.equal_range(m_entries.back().first.hash);
+      for (; index != end; ++index)
+        if (index->second == std::prev(m_entries.end())) {
+          m_index.erase(index);
+          break;
+        }
+      m_bytes -= m_entries.back().first.bytes;
+      m_entries.pop_back();
+    }
+  }
+
+  /**
+   * @brief Determine the memory of a cached "basis".
+   *
+   * @param basis cached basis.
+   * @return size_t memory of the basis in bytes.
+   */
+  static size_t getBasisBytes(const Basis &basis) {
+    return sizeof(Basis) + basis.knots().size() * sizeof(double);
+  }
+
+  /**
+   * @brief Determine the hash of an operation.
+   *
+   * @param operation operation type.
+   * @param interp interpolation type hash.
+   * @param operands operand bases.
+   * @param parameters operation parameters.
+   * @return size_t hash value.
+   */
+  static size_t getHash(int operation, size_t interp,
+                        std::initializer_list<const Basis *> operands,
+                        std::initializer_list<double> parameters) {
+    size_t hash{std::hash<int>{}(operation) ^ interp};
+    const auto combine{[&hash](size_t value) {
+      hash ^= value + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+    }};
+    for (const Basis *operand : operands)
+      combine(operand->hash());
+    for (double parameter : parameters)
+      combine(std::hash<double>{}(parameter));
+    return hash;
+  }
+};
+
+#ifdef BASIS_SPLINES_COMPILED
+// instantiated in the compiled library, see src/basisSplines.cpp
+extern template std::shared_ptr<const TransformCache::Transform>
+TransformCache::add<Interpolate>(const Basis &, const Basis &, double,
+                                 double);
+extern template std::shared_ptr<const TransformCache::Transform>
+TransformCache::prod<Interpolate>(const Basis &, const Basis &, double,
+                                  double);
+#endif
+}; // namespace BasisSplines
+
+#endif
@@ -0,0 +1,56 @@
+/**
+ * @file basisSplines.cpp
+ * @brief Explicit instantiations of the compiled basisSplines library.
+ *
+ * With BASIS_SPLINES_COMPILED, the headers declare the instantiations below as
+ * extern, such that translation units using the library do not instantiate
+ * them again.
+ */
+
+#include "basisSplines/basis.h"
+#include "basisSplines/interpolate.h"
+#include "basisSplines/spline.h"
+#include "basisSplines/transformCache.h"
+
+template class Eigen::ColPivHouseholderQR<Eigen::MatrixXd>;
+
+namespace BasisSplines {
+
+// MARK: basis and interpolation
+
+template std::pair<Eigen::MatrixXd, Eigen::MatrixXd>
+Basis::add<Interpolate>(const Basis &, Basis &, double, double) const;
+template Eigen::MatrixXd Basis::prod<Interpolate>(const Basis &, Basis &,
+                                                  double, double) const;
+template Eigen::MatrixXd
+Interpolate::fit<Eigen::ColPivHouseholderQR<Eigen::MatrixXd>>(
+    const Eigen::MatrixXd &, const Eigen::VectorXd &) const;
+template Eigen::MatrixXd
+Interpolate::fit<Eigen::ColPivHouseholderQR<Eigen::MatrixXd>>(
+    const std::vector<Eigen::MatrixXd> &, const std::vector<Eigen::VectorXi> &,
+    const Eigen::ArrayXd &) const;
+
+// MARK: spline
+
+template Spline Spline::add<Interpolate>(const Spline &, double,
+                                         double) const;
+template void Spline::addInto<Interpolate>(const Spline &, Spline &, double,
+                                           double) const;
+template Spline Spline::prod<Interpolate>(const Spline &, double,
+                                          double) const;
+template void Spline::prodInto<Interpolate>(const Spline &, Spline &, double,
+                                            double) const;
+template Spline Spline::compose<Interpolate>(const Spline &, double,
+                                             double) const;
+template Spline Spline::orderElevation<Interpolate>(int) const;
+template Spline Spline::getClamped<Interpolate>() const;
+
+// MARK: transform cache
+
+template std::shared_ptr<const TransformCache::Transform>
+TransformCache::add<Interpolate>(const Basis &, const Basis &, double,
+                                 double);
+template std::shared_ptr<const TransformCache::Transform>
+TransformCache::prod<Interpolate>(const Basis &, const Basis &, double,
+                                  double);
+}; // namespace BasisSplines
@@ -0,0 +1,180 @@
+#include <Eigen/Core>
+#include <chrono>
+#include <future>
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+#include "basisSplines/async.h"
+#include "basisSplines/basis.h"
+#include "basisSplines/executor.h"
+#include "basisSplines/interpolate.h"
+#include "basisSplines/spline.h"
+#include "testBase.h"
+
+namespace BasisSplines {
+namespace Internal {
+class AsyncTest : public TestBase {
+protected:
+  const std::shared_ptr<Basis> m_basisO3{std::make_shared<Basis>(
+      Eigen::ArrayXd{{0.0, 0.0, 0.0, 0.25, 0.5, 0.75, 1.0, 1.0, 1.0}}, 3)};
+  const std::shared_ptr<Basis> m_basisO4{std::make_shared<Basis>(
+      Eigen::ArrayXd{{0.0, 0.0, 0.0, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 1.0, 1.0,
+                      1.0}},
+      4)};
+  const Spline m_splineO3{m_basisO3,
+                          Eigen::MatrixXd::Random(m_basisO3->dim(), 2)};
+  const Spline m_splineO4{m_basisO4,
+                          Eigen::MatrixXd::Random(m_basisO4->dim(), 2)};
+};
+
+/**
+ * @brief Test asynchronous sums, products and roots coincide with the
+ * synchronous operations.
+ *
+ */
+TEST_F(AsyncTest, Operations) {
+  Future<Spline> sum{Async::add(m_splineO3, m_splineO4)};
+  Future<Spline> prod{Async::prod(m_splineO3, m_splineO4)};
+  Future<std::vector<Eigen::ArrayXd>> roots{Async::getRoots(m_splineO4)};
+
+  const Eigen::ArrayXd points{Eigen::ArrayXd::LinSpaced(21, 0.0, 1.0)};
+  expectAllClose(sum.get()(points), m_splineO3.add(m_splineO4)(points),
+                 1e-12);
+  expectAllClose(prod.get()(points), m_splineO3.prod(m_splineO4)(points),
+                 1e-12);
+
+  const std::vector<Eigen::ArrayXd> rootsExp{m_splineO4.getRoots()};
+  const std::vector<Eigen::ArrayXd> rootsEst{roots.get()};
+  ASSERT_EQ(rootsEst.size(), rootsExp.size());
+  for (size_t dim{}; dim < rootsEst.size(); ++dim)
+    expectAllClose(rootsEst[dim], rootsExp[dim], 1e-14);
+}
+
+/**
+ * @brief Test asynchronous fits to observations and processes coincide with
+ * the synchronous fits.
+ *
+ */
+TEST_F(AsyncTest, Fit) {
+  const Eigen::VectorXd points{m_basisO4->greville()};
+  Eigen::MatrixXd observations{m_splineO4(points)};
+  Future<Spline> fitObs{Async::fit(m_basisO4, observations, points)};
+  observations.setZero();
+
+  Future<Spline> fitProcess{Async::fit(
+      m_basisO4, [&](const Eigen::VectorXd &points) {
+        return Eigen::MatrixXd{m_splineO4(points)};
+      })};
+
+  expectAllClose(Eigen::ArrayXXd{fitObs.get().getCoefficients()},
+                 Eigen::ArrayXXd{m_splineO4.getCoefficients()}, 1e-10);
+  expectAllClose(Eigen::ArrayXXd{fitProcess.get().getCoefficients()},
+                 Eigen::ArrayXXd{m_splineO4.getCoefficients()}, 1e-10);
+}
+
+/**
+ * @brief Test the caller may modify the argument bases while the operations
+ * are pending.
+ *
+ */
+TEST_F(AsyncTest, CopyBasis) {
+  const std::shared_ptr<Basis> basis{std::make_shared<Basis>(*m_basisO4)};
+  const Spline spline{basis, m_splineO4.getCoefficients()};
+  const Eigen::VectorXd points{basis->greville()};
+  Future<Spline> fitObs{Async::fit(basis, spline(points).matrix(), points)};
+  Future<Spline> sum{Async::add(spline, spline)};
+  basis->setScale(2.0);
+
+  const Spline fitted{fitObs.get()};
+  EXPECT_NE(fitted.basis(), basis);
+  EXPECT_EQ(fitted.basis()->getScale(), 1.0);
+  EXPECT_EQ(sum.get().basis()->getScale(), 1.0);
+}
+
+/**
+ * @brief Test exceptions of an operation are rethrown by Future::get.
+ *
+ */
+TEST_F(AsyncTest, Exception) {
+  Future<int> future{
+      Async::launch([]() -> int { throw std::runtime_error("failed"); })};
+  EXPECT_THROW(future.get(), std::runtime_error);
+  EXPECT_FALSE(future.valid());
+}
+
+/**
+ * @brief Test cancelling a running operation stops its next parallel loop and
+ * cancelling a finished operation keeps its result.
+ *
+ */
+TEST_F(AsyncTest, Cancel) {
+  std::promise<void> started{};
+  std::promise<void> release{};
+  std::shared_future<void> released{release.get_future().share()};
+
+  Future<std::vector<Eigen::ArrayXd>> roots{Async::launch([&, released]() {
+    started.set_value();
+    released.wait();
+    return m_splineO4.getRoots();
+  })};
+
+  started.get_future().wait();
+  EXPECT_FALSE(roots.isReady());
+  EXPECT_TRUE(roots.cancel());
+  EXPECT_FALSE(roots.cancel());
+  release.set_value();
+  EXPECT_THROW(roots.get(), OperationCancelled);
+
+  Future<int> finished{Async::launch([]() { return 1; })};
+  finished.wait();
+  EXPECT_TRUE(finished.isReady());
+  finished.cancel();
+  EXPECT_EQ(finished.get(), 1);
+}
+
+/**
+ * @brief Test operations waiting for nested operations complete regardless of
+ * the number of background workers.
+ *
+ */
+TEST_F(AsyncTest, Nested) {
+  std::vector<Future<bool>> outers{};
+  for (int cOuter{}; cOuter < 2 * Executor::getNumThreads() + 2; ++cOuter)
+    outers.push_back(Async::launch([&]() {
+      Future<Spline> sum{Async::add(m_splineO3, m_splineO4)};
+      const bool isReady{sum.isReady()};
+      sum.get();
+      return isReady;
+    }));
+
+  // nested operations are finished on launch
+  for (Future<bool> &outer : outers)
+    EXPECT_TRUE(outer.get());
+}
+
+/**
+ * @brief Test the cancellation is observed in functions executed with a stop
+ * token.
+ *
+ */
+TEST_F(AsyncTest, StopToken) {
+  std::stop_source stopSource{};
+  EXPECT_FALSE(Executor::withStopToken(
+      stopSource.get_token(), []() { return Executor::isCancelled(); }));
+
+  stopSource.request_stop();
+  EXPECT_THROW(Executor::withStopToken(stopSource.get_token(),
+                                       [&]() { m_splineO3.getRoots(); }),
+               OperationCancelled);
+  EXPECT_FALSE(Executor::isCancelled());
+  EXPECT_NO_THROW(m_splineO3.getRoots());
+}
+
+}; // namespace Internal
+}; // namespace BasisSplines
+
+int main(int argc, char **argv) {
+  std::srand(0);
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
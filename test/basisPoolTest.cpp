@@ -0,0 +1,106 @@
+#include <Eigen/Core>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+#include "basisSplines/basis.h"
+#include "basisSplines/basisPool.h"
+#include "basisSplines/spline.h"
+#include "testBase.h"
+
+namespace BasisSplines {
+namespace Internal {
+class BasisPoolTest : public TestBase {
+protected:
+  const std::shared_ptr<Basis> m_basisO3{std::make_shared<Basis>(
+      Eigen::ArrayXd{{0.0, 0.0, 0.0, 0.4, 0.6, 1.0, 1.0, 1.0}}, 3)};
+  const Spline m_splineA{m_basisO3,
+                         Eigen::MatrixXd::Random(m_basisO3->dim(), 2)};
+  const Spline m_splineB{m_basisO3,
+                         Eigen::MatrixXd::Random(m_basisO3->dim(), 2)};
+
+  void TearDown() override {
+    BasisPool::setEnabled(false);
+    BasisPool::global().clear();
+  }
+};
+
+/**
+ * @brief Test derived splines share their basis only if the pool is enabled.
+ *
+ */
+TEST_F(BasisPoolTest, DerivativeShared) {
+  EXPECT_NE(m_splineA.derivative().basis(), m_splineB.derivative().basis());
+
+  BasisPool::setEnabled(true);
+  EXPECT_EQ(m_splineA.derivative().basis(), m_splineB.derivative().basis());
+  EXPECT_EQ(m_splineA.add(m_splineB).basis(), m_splineB.add(m_splineA).basis());
+  EXPECT_NE(m_splineA.derivative().basis(), m_splineA.integral().basis());
+
+  // pooled values coincide with unpooled values
+  const Eigen::ArrayXd points{Eigen::ArrayXd::LinSpaced(21, 0.0, 1.0)};
+  const Spline deriv{m_splineB.derivative()};
+  BasisPool::setEnabled(false);
+  expectAllClose(deriv(points), m_splineB.derivative()(points), 1e-12);
+}
+
+/**
+ * @brief Test interning of bases with different order, scale or knots and
+ * release of unused bases.
+ *
+ */
+TEST_F(BasisPoolTest, InternRelease) {
+  BasisPool pool{};
+  const std::shared_ptr<Basis> basis{pool.intern(m_basisO3)};
+  EXPECT_EQ(basis, m_basisO3);
+  EXPECT_EQ(pool.intern(Basis{*m_basisO3}), m_basisO3);
+  EXPECT_NE(pool.intern(Basis{m_basisO3->knots(), 2}), m_basisO3);
+  EXPECT_NE(pool.intern(Basis{m_basisO3->knots(), 3, 2.0}), m_basisO3);
+  EXPECT_NE(pool.intern(Basis{m_basisO3->knots() + 1e-12, 3}), m_basisO3);
+
+  // only bases used outside the pool remain
+  EXPECT_EQ(pool.size(), 1);
+}
+
+/**
+ * @brief Test expired bases are removed while distinct bases are interned,
+ * such that the pool does not grow with the number of released bases.
+ *
+ */
+TEST_F(BasisPoolTest, PruneExpired) {
+  BasisPool pool{};
+  const std::shared_ptr<Basis> basis{pool.intern(m_basisO3)};
+  for (int cBasis{}; cBasis < 10000; ++cBasis)
+    pool.intern(Basis{m_basisO3->knots() + cBasis, 3});
+
+  EXPECT_LE(pool.getNumEntries(), 128);
+  EXPECT_EQ(pool.size(), 1);
+  EXPECT_EQ(pool.intern(Basis{*m_basisO3}), basis);
+}
+
+/**
+ * @brief Test concurrent interning of equal bases.
+ *
+ */
+TEST_F(BasisPoolTest, InternConcurrent) {
+  BasisPool pool{};
+  std::vector<std::shared_ptr<Basis>> bases(8);
+  std::vector<std::thread> threads{};
+  for (auto &basis : bases)
+    threads.emplace_back(
+        [&]() { basis = pool.intern(Basis{m_basisO3->knots(), 3}); });
+  for (auto &thread : threads)
+    thread.join();
+
+  for (const auto &basis : bases)
+    EXPECT_EQ(basis, bases[0]);
+}
+
+}; // namespace Internal
+}; // namespace BasisSplines
+
+int main(int argc, char **argv) {
+  std::srand(0);
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
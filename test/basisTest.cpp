@@ -1,5 +1,6 @@
 #include <Eigen/Core>
 #include <gtest/gtest.h>
+#include <unordered_set>
 
 #include "basisSplines/basis.h"
 #include "basisSplines/interpolate.h"
@@ -549,6 +550,142 @@ TEST_F(BasisTest, SetBreakpointsNegativeNonIncreasing) {
   expectAllClose(breakpointsGtr, breakpointsEst, 1e-8);
 }
 
+/**
+ * @brief Test span lookup with binary search and span index against the basis
+ * evaluation. The span's last basis function must be non-zero.
+ *
+ */
+TEST_F(BasisTest, GetSpanO3) {
+  Basis basis{*m_basisO3Seg3};
+  const Eigen::ArrayXd points{Eigen::ArrayXd::LinSpaced(1001, -0.1, 1.1)};
+
+  for (int bucketsPerKnot : {0, 1, 4}) {
+    basis.setSpanIndex(bucketsPerKnot);
+    for (double point : points) {
+      const int span{basis.getSpan(point)};
+
+      // points outside knots
+      if (point < -1e-6 || point > 1.0 + 1e-6) {
+        EXPECT_EQ(span, -1);
+        continue;
+      }
+
+      // right closed non-empty spans
+      const double pointIn{std::clamp(point, 0.0, 1.0)};
+      EXPECT_LT(basis.knots()(span), basis.knots()(span + 1));
+      EXPECT_TRUE(basis.knots()(span) < pointIn ||
+                  span == basis.order() - 1);
+      EXPECT_LE(pointIn, basis.knots()(span + 1));
+    }
+  }
+
+  // span at repeated interior knot is left of the knot
+  EXPECT_EQ(basis.getSpan(0.6), 3);
+  EXPECT_EQ(basis.getSpan(0.6 + 1e-9), 5);
+}
+
+/**
+ * @brief Test span lookup with span index on clustered random knots.
+ *
+ */
+TEST_F(BasisTest, GetSpanIndexRandom) {
+  Eigen::ArrayXd knots{Eigen::ArrayXd::Random(1000).pow(3)};
+  std::sort(knots.begin(), knots.end());
+  Basis basis{knots, 4};
+  const Basis basisRef{basis};
+  basis.setSpanIndex();
+
+  const Eigen::ArrayXd points{Eigen::ArrayXd::Random(10000)};
+  for (double point : points)
+    EXPECT_EQ(basis.getSpan(point), basisRef.getSpan(point));
+  for (double knot : knots)
+    EXPECT_EQ(basis.getSpan(knot), basisRef.getSpan(knot));
+}
+
+/**
+ * @brief Test span-local basis values against dense basis values on bases with
+ * repeated and unclamped knots.
+ *
+ */
+TEST_F(BasisTest, EvalSpanO3) {
+  const Eigen::ArrayXd points{
+      Eigen::ArrayXd::LinSpaced(1001, -1e-7, 1.0 + 1e-7)};
+  const Basis basisOpen{Eigen::ArrayXd{{0.0, 0.1, 0.2, 0.6, 0.6, 0.8, 1.0}}, 3};
+
+  for (const Basis &basis : {*m_basisO3Seg3, basisOpen}) {
+    const Eigen::MatrixXd valuesGtr{basis(points)};
+    Eigen::VectorXd values(basis.order());
+    for (int cPoint{}; cPoint < points.size(); ++cPoint) {
+      const int span{basis.getSpan(points(cPoint))};
+      basis.evalSpan(points(cPoint), span, values);
+
+      Eigen::ArrayXd valuesEst{Eigen::ArrayXd::Zero(basis.dim())};
+      for (int cValue{}; cValue < basis.order(); ++cValue) {
+        const int func{span - basis.order() + 1 + cValue};
+        if (func >= 0 && func < basis.dim())
+          valuesEst(func) = values(cValue);
+      }
+      const Eigen::ArrayXd valuesGtrPoint{valuesGtr.row(cPoint).transpose()};
+      expectAllClose(valuesEst, valuesGtrPoint, 1e-12);
+    }
+  }
+}
+
+/**
+ * @brief Test basis hash and equality for copies, modifications and unordered
+ * containers.
+ *
+ */
+TEST_F(BasisTest, HashEqual) {
+  const Basis basis{*m_basisO3Seg3};
+  Basis basisMod{basis};
+  EXPECT_TRUE(basis == basisMod);
+  EXPECT_EQ(basis.hash(), basisMod.hash());
+
+  // modifications change equality and hash
+  basisMod.setScale(2.0);
+  EXPECT_FALSE(basis == basisMod);
+  EXPECT_NE(basis.hash(), basisMod.hash());
+  basisMod.setScale(basis.getScale());
+  EXPECT_TRUE(basis == basisMod);
+
+  const Basis basisOrder{basis.knots(), basis.order() + 1};
+  const Basis basisKnots{basis.knots() + 1e-12, basis.order()};
+  EXPECT_FALSE(basis == basisOrder);
+  EXPECT_FALSE(basis == basisKnots);
+
+  // quantised hash identifies knots within tolerance
+  EXPECT_EQ(basis.hash(1e-6), basisKnots.hash(1e-6));
+
+  const std::unordered_set<Basis> bases{basis, basisMod, basisOrder,
+                                        basisKnots};
+  EXPECT_EQ(bases.size(), 3);
+}
+
+/**
+ * @brief Test affine maps of the basis knots, rvalue bases and invalid
+ * factors.
+ *
+ */
+TEST_F(BasisTest, Affine) {
+  const Basis basis{m_basisO3Seg3->affine(2.0, -1.0)};
+  expectAllClose(basis.knots(),
+                 Eigen::ArrayXd{2.0 * m_basisO3Seg3->knots() - 1.0}, 1e-14);
+  EXPECT_EQ(basis.order(), m_basisO3Seg3->order());
+  EXPECT_FALSE(basis == *m_basisO3Seg3);
+  EXPECT_TRUE(basis == m_basisO3Seg3->affine(2.0, -1.0));
+
+  // rvalue basis maps its knots in place
+  Basis basisMoved{*m_basisO3Seg3};
+  const double *dataKnots{basisMoved.knots().data()};
+  const Basis basisMapped{std::move(basisMoved).affine(2.0, -1.0)};
+  EXPECT_EQ(basisMapped.knots().data(), dataKnots);
+  EXPECT_TRUE(basisMapped == basis);
+
+  EXPECT_THROW(m_basisO3Seg3->affine(0.0, 1.0), std::invalid_argument);
+  EXPECT_THROW(m_basisO3Seg3->affine(-1.0, 1.0), std::invalid_argument);
+}
+
 }; // namespace Internal
 }; // namespace BasisSplines
 
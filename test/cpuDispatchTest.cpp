@@ -0,0 +1,106 @@
+#include <Eigen/Core>
+#include <gtest/gtest.h>
+
+#include "basisSplines/basis.h"
+#include "basisSplines/cpuDispatch.h"
+#include "basisSplines/math.h"
+#include "basisSplines/spline.h"
+#include "testBase.h"
+
+namespace BasisSplines {
+namespace Internal {
+class CpuDispatchTest : public TestBase {
+protected:
+  const std::shared_ptr<Basis> m_basisO4{std::make_shared<Basis>(
+      Eigen::ArrayXd{{0.0, 0.0, 0.0, 0.0, 0.3, 0.5, 0.5, 1.0, 1.0, 1.0, 1.0}},
+      4)};
+  const std::shared_ptr<Basis> m_basisO5{std::make_shared<Basis>(
+      Eigen::ArrayXd{{0.0, 0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8, 0.9, 1.0}},
+      5)};
+  const Eigen::ArrayXd m_points{0.6 * Eigen::ArrayXd::Random(203) + 0.5};
+
+  /**
+   * @brief Get the instruction set levels supported by the CPU.
+   *
+   * @return std::vector<Isa> supported instruction set levels.
+   */
+  static std::vector<Isa> getLevels() {
+    std::vector<Isa> levels{};
+    for (Isa isa : {Isa::baseline, Isa::avx2, Isa::avx512})
+      if (isa <= CpuDispatch::getSupported())
+        levels.push_back(isa);
+    return levels;
+  }
+
+  void TearDown() override {
+    CpuDispatch::setActive(CpuDispatch::getSupported());
+  }
+};
+
+/**
+ * @brief Test the active level is limited by the CPU and names correspond
+ * with the levels.
+ *
+ */
+TEST_F(CpuDispatchTest, SelectLevel) {
+  EXPECT_LE(CpuDispatch::getActive(), CpuDispatch::getSupported());
+
+  CpuDispatch::setActive(Isa::avx512);
+  EXPECT_EQ(CpuDispatch::getActive(), CpuDispatch::getSupported());
+  CpuDispatch::setActive(Isa::baseline);
+  EXPECT_EQ(CpuDispatch::getActive(), Isa::baseline);
+
+  for (Isa isa : {Isa::baseline, Isa::avx2, Isa::avx512})
+    EXPECT_EQ(CpuDispatch::fromName(CpuDispatch::getName(isa)), isa);
+  EXPECT_EQ(CpuDispatch::fromName("sse2"), Isa::baseline);
+}
+
+/**
+ * @brief Test span-sorted evaluation coincides with basis evaluation for all
+ * supported levels, including points outside the knots and non-existing
+ * basis functions of a basis without repeated boundary knots.
+ *
+ */
+TEST_F(CpuDispatchTest, EvalSortedLevels) {
+  for (const std::shared_ptr<Basis> &basis : {m_basisO4, m_basisO5}) {
+    const Spline spline{basis, Eigen::MatrixXd::Random(basis->dim(), 3)};
+    const Eigen::ArrayXXd valuesGt{
+        (*basis)(m_points).matrix() * spline.getCoefficients()};
+
+    for (Isa isa : getLevels()) {
+      CpuDispatch::setActive(isa);
+      expectAllClose(spline.evalSorted(m_points), valuesGt, 1e-12);
+    }
+  }
+}
+
+/**
+ * @brief Test the Khatri-Rao product coincides for all supported levels with
+ * column numbers not divisible by the vector widths.
+ *
+ */
+TEST_F(CpuDispatchTest, KhatriRaoLevels) {
+  const Eigen::MatrixXd matL{Eigen::MatrixXd::Random(13, 3)};
+  const Eigen::MatrixXd matR{Eigen::MatrixXd::Random(13, 5)};
+
+  Eigen::ArrayXXd valuesGt(13, 15);
+  for (Eigen::Index cRow{}; cRow < 13; ++cRow)
+    for (Eigen::Index cColL{}; cColL < 3; ++cColL)
+      for (Eigen::Index cColR{}; cColR < 5; ++cColR)
+        valuesGt(cRow, cColL * 5 + cColR) =
+            matL(cRow, cColL) * matR(cRow, cColR);
+
+  for (Isa isa : getLevels()) {
+    CpuDispatch::setActive(isa);
+    expectAllClose(Eigen::ArrayXXd{khatriRao(matL, matR)}, valuesGt, 1e-12);
+  }
+}
+
+}; // namespace Internal
+}; // namespace BasisSplines
+
+int main(int argc, char **argv) {
+  std::srand(0);
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,320 @@
+#include <Eigen/Core>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <stop_token>
+#include <thread>
+
+#include "basisSplines/basis.h"
+#include "basisSplines/executor.h"
+#include "basisSplines/interpolate.h"
+#include "basisSplines/spline.h"
+#include "testBase.h"
+
+namespace BasisSplines {
+namespace Internal {
+class ExecutorTest : public TestBase {
+protected:
+  const std::shared_ptr<Basis> m_basisO4{std::make_shared<Basis>(
+      Eigen::ArrayXd{{0.0, 0.0, 0.0, 0.0, 0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7,
+                      0.8, 0.9, 1.0, 1.0, 1.0, 1.0}},
+      4)};
+  const Spline m_spline{m_basisO4,
+                        Eigen::MatrixXd::Random(m_basisO4->dim(), 3)};
+  const Eigen::ArrayXd m_points{0.5 * Eigen::ArrayXd::Random(5000) + 0.5};
+
+  void SetUp() override {
+    m_numThreads = Executor::getNumThreads();
+    m_grainSize = Executor::getGrainSize();
+  }
+
+  void TearDown() override {
+    Executor::setNumThreads(m_numThreads);
+    Executor::setGrainSize(m_grainSize);
+    Executor::setBackend({});
+  }
+
+private:
+  int m_numThreads{};
+  Eigen::Index m_grainSize{};
+};
+
+/**
+ * @brief Test parallel loops run serially by default.
+ *
+ */
+TEST_F(ExecutorTest, DefaultSerial) {
+  if (std::getenv("BASIS_SPLINES_NUM_THREADS"))
+    GTEST_SKIP() << "Number of threads set by environment.";
+  if (BASIS_SPLINES_DEFAULT_NUM_THREADS > 0)
+    EXPECT_EQ(Executor::getNumThreads(), BASIS_SPLINES_DEFAULT_NUM_THREADS);
+  if (BASIS_SPLINES_DEFAULT_NUM_THREADS == 1)
+    EXPECT_TRUE(Executor::isSerial());
+}
+
+/**
+ * @brief Test each index is processed exactly once in chunks of at least the
+ * grain size.
+ *
+ */
+TEST_F(ExecutorTest, ParallelForCoverage) {
+  Executor::setNumThreads(4);
+  std::vector<std::atomic<int>> counts(1003);
+  std::atomic<Eigen::Index> minChunk{1003};
+
+  Executor::parallelFor(
+      0, 1003,
+      [&](Eigen::Index begin, Eigen::Index end) {
+        const Eigen::Index chunk{end - begin};
+        Eigen::Index current{minChunk};
+        while (chunk < current &&
+               !minChunk.compare_exchange_weak(current, chunk))
+          ;
+        for (Eigen::Index idx{begin}; idx < end; ++idx)
+          ++counts[idx];
+      },
+      10);
+
+  for (const std::atomic<int> &count : counts)
+    EXPECT_EQ(count, 1);
+  EXPECT_GE(minChunk, 10);
+  EXPECT_LT(minChunk, 1003);
+}
+
+/**
+ * @brief Test a single thread runs the loop serially on the calling thread and
+ * nested loops run serially.
+ *
+ */
+TEST_F(ExecutorTest, SerialAndNested) {
+  Executor::setNumThreads(1);
+  EXPECT_TRUE(Executor::isSerial());
+  const std::thread::id caller{std::this_thread::get_id()};
+  int numChunks{};
+  Executor::parallelFor(
+      0, 100,
+      [&](Eigen::Index, Eigen::Index) {
+        EXPECT_EQ(std::this_thread::get_id(), caller);
+        ++numChunks;
+      },
+      1);
+  EXPECT_EQ(numChunks, 1);
+
+  Executor::setNumThreads(4);
+  EXPECT_FALSE(Executor::isSerial());
+  std::atomic<int> numInner{};
+  Executor::parallelFor(
+      0, 8,
+      [&](Eigen::Index, Eigen::Index) {
+        EXPECT_TRUE(Executor::isSerial());
+        Executor::parallelFor(
+            0, 100, [&](Eigen::Index, Eigen::Index) { ++numInner; }, 1);
+      },
+      1);
+  EXPECT_EQ(numInner, 8);
+}
+
+/**
+ * @brief Test exceptions of a chunk are rethrown to the caller and the pool
+ * remains usable.
+ *
+ */
+TEST_F(ExecutorTest, Exception) {
+  Executor::setNumThreads(4);
+  EXPECT_THROW(Executor::parallelFor(
+                   0, 100,
+                   [](Eigen::Index begin, Eigen::Index) {
+                     if (begin > 50)
+                       throw std::runtime_error("chunk failed");
+                   },
+                   1),
+               std::runtime_error);
+
+  std::atomic<int> sum{};
+  Executor::parallelFor(
+      0, 100,
+      [&](Eigen::Index begin, Eigen::Index end) {
+        sum += static_cast<int>(end - begin);
+      },
+      1);
+  EXPECT_EQ(sum, 100);
+}
+
+/**
+ * @brief Test cancellable loops on several threads. Short chunks of a loop
+ * that is not cancelled all run, and a stop requested within a loop is
+ * observed by the chunks on all threads and the loop throws
+ * OperationCancelled.
+ *
+ */
+TEST_F(ExecutorTest, Cancellation) {
+  Executor::setNumThreads(4);
+  std::stop_source source{};
+
+  // chunks of the caller wait for a chunk on a worker, such that workers
+  // start their chunks while the caller executes one. The flag is relaxed to
+  // not order the chunks. Loops alternate between the empty token and the
+  // token of "source".
+  const std::thread::id caller{std::this_thread::get_id()};
+  for (int cLoop{}; cLoop < 20; ++cLoop) {
+    std::atomic<bool> workerStarted{};
+    Eigen::ArrayXi processed{Eigen::ArrayXi::Zero(100)};
+    const auto loop{[&]() {
+      Executor::parallelFor(
+          0, 100,
+          [&](Eigen::Index begin, Eigen::Index end) {
+            if (std::this_thread::get_id() != caller)
+              workerStarted.store(true, std::memory_order_relaxed);
+            else {
+              const auto timeout{std::chrono::steady_clock::now() +
+                                 std::chrono::seconds{5}};
+              while (!workerStarted.load(std::memory_order_relaxed) &&
+                     std::chrono::steady_clock::now() < timeout)
+                std::this_thread::yield();
+            }
+            if (!Executor::isCancelled())
+              processed.segment(begin, end - begin).setOnes();
+          },
+          1);
+    }};
+    if (cLoop % 2 == 0)
+      loop();
+    else
+      Executor::withStopToken(source.get_token(), loop);
+    EXPECT_TRUE((processed == 1).all());
+  }
+
+  std::atomic<int> numStarted{};
+  std::atomic<int> numObserved{};
+
+  // the first chunk requests the stop and all started chunks wait for it
+  const auto loopCancelled{[&]() {
+    Executor::parallelFor(
+        0, 1000,
+        [&](Eigen::Index begin, Eigen::Index) {
+          ++numStarted;
+          if (begin == 0)
+            source.request_stop();
+          const auto timeout{std::chrono::steady_clock::now() +
+                             std::chrono::seconds{5}};
+          while (!Executor::isCancelled() &&
+                 std::chrono::steady_clock::now() < timeout)
+            std::this_thread::yield();
+          if (Executor::isCancelled())
+            ++numObserved;
+        },
+        1);
+  }};
+  EXPECT_THROW(Executor::withStopToken(source.get_token(), loopCancelled),
+               OperationCancelled);
+
+  EXPECT_GE(numStarted, 1);
+  EXPECT_EQ(numObserved, numStarted);
+  EXPECT_FALSE(Executor::isCancelled());
+  std::atomic<int> sum{};
+  Executor::parallelFor(
+      0, 100,
+      [&](Eigen::Index begin, Eigen::Index end) {
+        EXPECT_FALSE(Executor::isCancelled());
+        sum += static_cast<int>(end - begin);
+      },
+      1);
+  EXPECT_EQ(sum, 100);
+}
+
+/**
+ * @brief Test a user-supplied backend executes all chunks.
+ *
+ */
+TEST_F(ExecutorTest, Backend) {
+  Executor::setNumThreads(4);
+  int numCalls{};
+  Executor::setBackend(
+      [&](Eigen::Index numTasks,
+          const std::function<void(Eigen::Index)> &task) {
+        ++numCalls;
+        for (Eigen::Index cTask{}; cTask < numTasks; ++cTask)
+          task(cTask);
+      });
+
+  int sum{};
+  Executor::parallelFor(
+      0, 100,
+      [&](Eigen::Index begin, Eigen::Index end) {
+        sum += static_cast<int>(end - begin);
+      },
+      1);
+  EXPECT_EQ(numCalls, 1);
+  EXPECT_EQ(sum, 100);
+}
+
+/**
+ * @brief Test changing the number of threads during a parallel loop of another
+ * thread keeps the running loop intact.
+ *
+ */
+TEST_F(ExecutorTest, SetNumThreadsDuringLoop) {
+  Executor::setNumThreads(4);
+  std::atomic<bool> started{};
+  std::atomic<bool> resized{};
+  std::atomic<int> sum{};
+  std::thread looper{[&]() {
+    Executor::parallelFor(
+        0, 100,
+        [&](Eigen::Index begin, Eigen::Index end) {
+          started = true;
+          while (!resized)
+            std::this_thread::yield();
+          sum += static_cast<int>(end - begin);
+        },
+        1);
+  }};
+
+  while (!started)
+    std::this_thread::yield();
+  Executor::setNumThreads(2);
+  resized = true;
+  looper.join();
+
+  EXPECT_EQ(sum, 100);
+  EXPECT_EQ(Executor::getNumThreads(), 2);
+}
+
+/**
+ * @brief Test parallel evaluation, fitting and root finding coincide with the
+ * serial results.
+ *
+ */
+TEST_F(ExecutorTest, SerialParallelEqual) {
+  Executor::setNumThreads(1);
+  const Eigen::ArrayXXd valuesSerial{m_spline.evalSorted(m_points)};
+  const Eigen::ArrayXXd basisSerial{(*m_basisO4)(m_points)};
+  const Eigen::ArrayXXd fitSerial{Interpolate{m_basisO4}.fit(
+      Eigen::MatrixXd{valuesSerial}, m_points.matrix())};
+  const std::vector<Eigen::ArrayXd> rootsSerial{m_spline.getRoots()};
+
+  Executor::setNumThreads(4);
+  Executor::setGrainSize(16);
+  expectAllClose(m_spline.evalSorted(m_points), valuesSerial, 1e-14);
+  expectAllClose(Eigen::ArrayXXd{(*m_basisO4)(m_points)}, basisSerial, 1e-14);
+  expectAllClose(Eigen::ArrayXXd{Interpolate{m_basisO4}.fit(
+                     Eigen::MatrixXd{valuesSerial}, m_points.matrix())},
+                 fitSerial, 1e-10);
+
+  Executor::setGrainSize(1);
+  const std::vector<Eigen::ArrayXd> roots{m_spline.getRoots()};
+  ASSERT_EQ(roots.size(), rootsSerial.size());
+  for (size_t dim{}; dim < roots.size(); ++dim)
+    expectAllClose(roots[dim], rootsSerial[dim], 1e-14);
+}
+
+}; // namespace Internal
+}; // namespace BasisSplines
+
+int main(int argc, char **argv) {
+  std::srand(0);
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
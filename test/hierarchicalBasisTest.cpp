@@ -0,0 +1,139 @@
+#include <Eigen/Core>
+#include <Eigen/Dense>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+#include "basisSplines/basis.h"
+#include "basisSplines/hierarchicalBasis.h"
+#include "basisSplines/spline.h"
+#include "testBase.h"
+
+namespace BasisSplines {
+namespace Internal {
+class HierarchicalBasisTest : public TestBase {
+protected:
+  const std::shared_ptr<Basis> m_basisO3{std::make_shared<Basis>(
+      Eigen::ArrayXd{{0.0, 0.0, 0.0, 0.25, 0.5, 0.75, 1.0, 1.0, 1.0}}, 3)};
+  const std::shared_ptr<Basis> m_basisO4{std::make_shared<Basis>(
+      Eigen::ArrayXd{{0.0, 0.0, 0.0, 0.0, 0.2, 0.4, 0.6, 0.8, 1.0, 1.0, 1.0,
+                      1.0}},
+      4)};
+  const Eigen::ArrayXd m_points{Eigen::ArrayXd::LinSpaced(1001, 0.0, 1.0)};
+
+  /**
+   * @brief Create a hierarchical basis refined twice around 0.3.
+   *
+   * @param basis basis of level 0.
+   * @return HierarchicalBasis locally refined basis.
+   */
+  static HierarchicalBasis refineLocal(const std::shared_ptr<Basis> &basis) {
+    HierarchicalBasis hierarchical{basis};
+    hierarchical.refine(0, 0.2, 0.45);
+    hierarchical.refine(1, 0.25, 0.35);
+    return hierarchical;
+  }
+};
+
+/**
+ * @brief Test the unrefined basis coincides with the level 0 basis.
+ *
+ */
+TEST_F(HierarchicalBasisTest, Unrefined) {
+  const HierarchicalBasis hierarchical{m_basisO4};
+
+  EXPECT_EQ(hierarchical.numLevels(), 1);
+  EXPECT_EQ(hierarchical.dim(), m_basisO4->dim());
+  expectAllClose(Eigen::ArrayXXd{hierarchical(m_points)},
+                 Eigen::ArrayXXd{(*m_basisO4)(m_points)}, 1e-14);
+}
+
+/**
+ * @brief Test the truncated functions of a locally refined basis form a
+ * partition of unity and are linearly independent.
+ *
+ */
+TEST_F(HierarchicalBasisTest, PartitionIndependence) {
+  for (const auto &basis : {m_basisO3, m_basisO4}) {
+    const HierarchicalBasis hierarchical{refineLocal(basis)};
+    const Eigen::MatrixXd values{hierarchical(m_points)};
+
+    EXPECT_EQ(hierarchical.numLevels(), 3);
+    EXPECT_GT(hierarchical.dim(), basis->dim());
+    EXPECT_LT(hierarchical.dim(), hierarchical.getBasis(2)->dim());
+    expectAllClose(Eigen::ArrayXd{values.rowwise().sum()},
+                   Eigen::ArrayXd{Eigen::ArrayXd::Ones(m_points.size())},
+                   1e-12);
+    EXPECT_TRUE((values.array() >= -1e-14).all());
+    EXPECT_EQ(Eigen::ColPivHouseholderQR<Eigen::MatrixXd>{values}.rank(),
+              hierarchical.dim());
+  }
+}
+
+/**
+ * @brief Test splines of the level 0 basis are reproduced by fitting and the
+ * resulting spline in the finest basis.
+ *
+ */
+TEST_F(HierarchicalBasisTest, ReproduceSpline) {
+  const HierarchicalBasis hierarchical{refineLocal(m_basisO4)};
+  const Spline spline{m_basisO4, Eigen::MatrixXd::Random(m_basisO4->dim(), 2)};
+
+  const Eigen::MatrixXd coeffs{
+      hierarchical.fit(spline(m_points), m_points.matrix())};
+
+  expectAllClose(Eigen::ArrayXXd{hierarchical(m_points) * coeffs},
+                 spline(m_points), 1e-10);
+  expectAllClose(hierarchical.toSpline(coeffs)(m_points), spline(m_points),
+                 1e-10);
+}
+
+/**
+ * @brief Test local refinement approximates a localized feature more
+ * accurately than the level 0 basis and with fewer functions than the
+ * uniformly refined basis.
+ *
+ */
+TEST_F(HierarchicalBasisTest, LocalFeature) {
+  const Eigen::MatrixXd values{(50.0 * (m_points - 0.3)).tanh()};
+  const auto error{[&](const Eigen::MatrixXd &valuesFit) {
+    return (valuesFit.array() - values.array()).abs().maxCoeff();
+  }};
+
+  HierarchicalBasis hierarchical{m_basisO4};
+  const double errorCoarse{
+      error(hierarchical(m_points) *
+            hierarchical.fit(values, m_points.matrix()))};
+  hierarchical.refine(0, 0.05, 0.55);
+  hierarchical.refine(1, 0.15, 0.45);
+  hierarchical.refine(2, 0.2, 0.4);
+  const double errorLocal{
+      error(hierarchical(m_points) *
+            hierarchical.fit(values, m_points.matrix()))};
+
+  EXPECT_LT(errorLocal, 0.1 * errorCoarse);
+  EXPECT_LT(hierarchical.dim(), hierarchical.getBasis(3)->dim() / 2);
+}
+
+/**
+ * @brief Test invalid bases and refinements are rejected.
+ *
+ */
+TEST_F(HierarchicalBasisTest, Invalid) {
+  EXPECT_THROW(HierarchicalBasis{std::make_shared<Basis>(
+                   Eigen::ArrayXd::LinSpaced(8, 0.0, 1.0), 3)},
+               std::invalid_argument);
+
+  HierarchicalBasis hierarchical{m_basisO3};
+  EXPECT_THROW(hierarchical.refine(1, 0.2, 0.4), std::invalid_argument);
+  EXPECT_THROW(hierarchical.refine(0, 0.4, 0.2), std::invalid_argument);
+}
+
+}; // namespace Internal
+}; // namespace BasisSplines
+
+int main(int argc, char **argv) {
+  std::srand(0);
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -43,5 +43,46 @@ TEST_F(MathTest, kron6x4) {
   expectAllClose(valuesEst, valuesGtr, 1e-10);
 }
 
+/**
+ * @brief Test splitting a quadratic Bezier curve at its center.
+ *
+ */
+TEST_F(MathTest, deCasteljauSplit) {
+  const Eigen::MatrixXd controlPoints{{0, 0}, {1, 2}, {2, 0}};
+  const auto [pointsL, pointsR] = deCasteljauSplit(controlPoints, 0.5);
+
+  // split point coincides with curve center
+  const Eigen::ArrayXd valuesGtr{deCasteljau(controlPoints, 0.5).array()};
+  expectAllClose(Eigen::ArrayXd{pointsL.row(2).transpose().array()}, valuesGtr,
+                 1e-10);
+  expectAllClose(Eigen::ArrayXd{pointsR.row(0).transpose().array()}, valuesGtr,
+                 1e-10);
+
+  // parts coincide with curve
+  expectAllClose(Eigen::ArrayXd{deCasteljau(pointsL, 0.5).array()},
+                 Eigen::ArrayXd{deCasteljau(controlPoints, 0.25).array()},
+                 1e-10);
+  expectAllClose(Eigen::ArrayXd{deCasteljau(pointsR, 0.5).array()},
+                 Eigen::ArrayXd{deCasteljau(controlPoints, 0.75).array()},
+                 1e-10);
+}
+
+/**
+ * @brief Test Gauss-Legendre quadrature integrates monomials up to degree 2n -
+ * 1 exactly.
+ *
+ */
+TEST_F(MathTest, gaussLegendreExact) {
+  for (int numNodes{1}; numNodes <= 8; ++numNodes) {
+    const auto [nodes, weights] = gaussLegendre(numNodes);
+
+    EXPECT_TRUE((nodes.tail(numNodes - 1) > nodes.head(numNodes - 1)).all());
+    for (int degree{}; degree < 2 * numNodes; ++degree) {
+      const double integralGtr{degree % 2 == 0 ? 2.0 / (degree + 1) : 0.0};
+      EXPECT_NEAR((weights * nodes.pow(degree)).sum(), integralGtr, 1e-13);
+    }
+  }
+}
+
 }; // namespace Internal
 }; // namespace BasisSplines
\ No newline at end of file
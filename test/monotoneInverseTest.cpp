@@ -0,0 +1,104 @@
+#include <Eigen/Core>
+#include <gtest/gtest.h>
+
+#include "basisSplines/basis.h"
+#include "basisSplines/monotoneInverse.h"
+#include "basisSplines/spline.h"
+#include "testBase.h"
+
+namespace BasisSplines {
+namespace Internal {
+class MonotoneInverseTest : public TestBase {
+protected:
+  const std::shared_ptr<Basis> m_basisO4{std::make_shared<Basis>(
+      Eigen::ArrayXd{{0.0, 0.0, 0.0, 0.0, 0.3, 0.5, 0.5, 0.8, 1.0, 1.0, 1.0,
+                      1.0}},
+      4)};
+
+  /**
+   * @brief Create coefficients increasing by random positive steps.
+   *
+   * @param size number of coefficients.
+   * @return Eigen::MatrixXd increasing coefficients.
+   */
+  static Eigen::MatrixXd increasingCoeffs(int size) {
+    Eigen::MatrixXd coeffs{
+        (Eigen::ArrayXd::Random(size) + 1.0).matrix() / 2.0};
+    for (int cRow{1}; cRow < size; ++cRow)
+      coeffs(cRow) += coeffs(cRow - 1);
+    return coeffs;
+  }
+
+  const Spline m_splineInc{m_basisO4, increasingCoeffs(m_basisO4->dim())};
+
+  const Eigen::ArrayXd m_points{Eigen::ArrayXd::LinSpaced(101, 0.0, 1.0)};
+};
+
+/**
+ * @brief Test inverse of an increasing spline of order 4 at its values.
+ *
+ */
+TEST_F(MonotoneInverseTest, InverseIncreasingO4) {
+  const MonotoneInverse inverse{m_splineInc};
+
+  const Eigen::ArrayXd values{m_splineInc(m_points).col(0)};
+  expectAllClose(inverse(values), m_points, 1e-8);
+
+  // spline values of inverted values coincide with queries
+  const Eigen::ArrayXd queries{
+      Eigen::ArrayXd::LinSpaced(57, values(0), values(values.size() - 1))};
+  expectAllClose(Eigen::ArrayXd{m_splineInc(inverse(queries)).col(0)},
+                 queries, 1e-10);
+}
+
+/**
+ * @brief Test inverse of a decreasing spline of order 4 for sorted queries.
+ *
+ */
+TEST_F(MonotoneInverseTest, InverseDecreasingSortedO4) {
+  const Spline spline{-m_splineInc};
+  const MonotoneInverse inverse{spline};
+
+  // queries sorted along decreasing spline values
+  const Eigen::ArrayXd values{spline(m_points).col(0)};
+  const Eigen::ArrayXd queries{
+      Eigen::ArrayXd::LinSpaced(57, values(values.size() - 1), values(0))
+          .reverse()};
+
+  expectAllClose(inverse(queries, true), inverse(queries), 1e-12);
+  expectAllClose(Eigen::ArrayXd{spline(inverse(queries, true)).col(0)},
+                 queries, 1e-10);
+}
+
+/**
+ * @brief Test mapping of values outside the spline range to domain ends.
+ *
+ */
+TEST_F(MonotoneInverseTest, InverseOutOfRange) {
+  const MonotoneInverse inverse{m_splineInc};
+  const Eigen::ArrayXd values{m_splineInc(m_points).col(0)};
+
+  EXPECT_DOUBLE_EQ(inverse(values(0) - 1.0), 0.0);
+  EXPECT_DOUBLE_EQ(inverse(values(values.size() - 1) + 1.0), 1.0);
+}
+
+/**
+ * @brief Test rejection of non-monotone splines.
+ *
+ */
+TEST_F(MonotoneInverseTest, NonMonotoneThrows) {
+  Eigen::MatrixXd coeffs{increasingCoeffs(m_basisO4->dim())};
+  coeffs(2) = coeffs(0) - 1.0;
+  const Spline spline{m_basisO4, coeffs};
+
+  EXPECT_THROW(MonotoneInverse{spline}, std::invalid_argument);
+}
+
+}; // namespace Internal
+}; // namespace BasisSplines
+
+int main(int argc, char **argv) {
+  std::srand(0);
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
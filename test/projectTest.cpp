@@ -0,0 +1,111 @@
+#include <Eigen/Core>
+#include <cmath>
+#include <gtest/gtest.h>
+
+#include "basisSplines/basis.h"
+#include "basisSplines/interpolate.h"
+#include "basisSplines/project.h"
+#include "basisSplines/spline.h"
+#include "testBase.h"
+
+namespace BasisSplines {
+namespace Internal {
+class ProjectTest : public TestBase {
+protected:
+  const std::shared_ptr<Basis> m_basisO3{std::make_shared<Basis>(
+      Eigen::ArrayXd{{0.0, 0.0, 0.0, 0.25, 0.5, 0.75, 1.0, 1.0, 1.0}}, 3)};
+  const std::shared_ptr<Basis> m_basisO4{std::make_shared<Basis>(
+      Eigen::ArrayXd{{0.0, 0.0, 0.0, 0.0, 0.1, 0.3, 0.3, 0.6, 0.8, 1.0, 1.0,
+                      1.0, 1.0}},
+      4)};
+  const Eigen::ArrayXd m_points{Eigen::ArrayXd::LinSpaced(1001, 0.0, 1.0)};
+
+  /**
+   * @brief Oscillating process with two output dimensions.
+   *
+   * @param points evaluation points.
+   * @return Eigen::MatrixXd process values.
+   */
+  static Eigen::MatrixXd process(const Eigen::VectorXd &points) {
+    Eigen::MatrixXd values(points.size(), 2);
+    values.col(0) = (12.0 * points.array()).sin();
+    values.col(1) = (-3.0 * points.array()).exp();
+    return values;
+  }
+};
+
+/**
+ * @brief Test the projection reproduces splines of the basis.
+ *
+ */
+TEST_F(ProjectTest, ReproduceSpline) {
+  const Spline spline{m_basisO4, Eigen::MatrixXd::Random(m_basisO4->dim(), 3)};
+
+  const Eigen::MatrixXd coeffs{Project{m_basisO4}.fit(
+      [&](const Eigen::VectorXd &points) { return spline(points); })};
+
+  expectAllClose(Eigen::ArrayXXd{coeffs},
+                 Eigen::ArrayXXd{spline.getCoefficients()}, 1e-10);
+}
+
+/**
+ * @brief Test the projection residual is orthogonal to the basis functions.
+ *
+ */
+TEST_F(ProjectTest, Orthogonality) {
+  const Project project{m_basisO3, 8};
+  const Spline spline{m_basisO3, project.fit(process)};
+
+  const Eigen::MatrixXd coeffsRes{project.fit(
+      [&](const Eigen::VectorXd &points) {
+        return Eigen::MatrixXd{process(points).array() - spline(points)};
+      })};
+
+  expectAllClose(Eigen::ArrayXXd{coeffsRes},
+                 Eigen::ArrayXXd{Eigen::ArrayXXd::Zero(m_basisO3->dim(), 2)},
+                 1e-12);
+}
+
+/**
+ * @brief Test the projection approximates an oscillating process more
+ * accurately than interpolation at the Greville sites.
+ *
+ */
+TEST_F(ProjectTest, AccuracyInterpolate) {
+  const Spline splineProj{m_basisO3, Project{m_basisO3, 8}.fit(process)};
+  const Spline splineInterp{m_basisO3, Interpolate{m_basisO3}.fit(process)};
+
+  const Eigen::ArrayXXd values{process(m_points.matrix())};
+  const Eigen::ArrayXd errorProj{
+      (splineProj(m_points) - values).square().colwise().mean().sqrt()};
+  const Eigen::ArrayXd errorInterp{
+      (splineInterp(m_points) - values).square().colwise().mean().sqrt()};
+
+  EXPECT_TRUE((errorProj < errorInterp).all());
+}
+
+/**
+ * @brief Test sum and product splines determined with Project as
+ * interpolation type coincide with Interpolate.
+ *
+ */
+TEST_F(ProjectTest, SumProd) {
+  const Spline splineL{m_basisO3,
+                       Eigen::MatrixXd::Random(m_basisO3->dim(), 2)};
+  const Spline splineR{m_basisO4,
+                       Eigen::MatrixXd::Random(m_basisO4->dim(), 2)};
+
+  expectAllClose(splineL.add<Project>(splineR)(m_points),
+                 splineL.add(splineR)(m_points), 1e-10);
+  expectAllClose(splineL.prod<Project>(splineR)(m_points),
+                 splineL.prod(splineR)(m_points), 1e-10);
+}
+
+}; // namespace Internal
+}; // namespace BasisSplines
+
+int main(int argc, char **argv) {
+  std::srand(0);
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
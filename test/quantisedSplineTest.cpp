@@ -0,0 +1,97 @@
+#include <Eigen/Core>
+#include <gtest/gtest.h>
+
+#include "basisSplines/basis.h"
+#include "basisSplines/quantisedSpline.h"
+#include "basisSplines/spline.h"
+#include "testBase.h"
+
+namespace BasisSplines {
+namespace Internal {
+class QuantisedSplineTest : public TestBase {
+protected:
+  const std::shared_ptr<Basis> m_basisO4{std::make_shared<Basis>(
+      Eigen::ArrayXd{{0.0, 0.0, 0.0, 0.0, 0.3, 0.5, 0.5, 0.8, 1.0, 1.0, 1.0,
+                      1.0}},
+      4)};
+  const Spline m_splineO4{m_basisO4,
+                          Eigen::MatrixXd::Random(m_basisO4->dim(), 3)};
+
+  const Eigen::ArrayXd m_points{Eigen::ArrayXd::LinSpaced(1001, 0.0, 1.0)};
+};
+
+/**
+ * @brief Test quantised spline values against the reported maximum error and
+ * the relative coefficient precision.
+ *
+ */
+TEST_F(QuantisedSplineTest, EvalO4) {
+  const QuantisedSpline quantised{m_splineO4};
+
+  const double error{
+      (quantised(m_points) - m_splineO4(m_points)).abs().maxCoeff()};
+  EXPECT_LE(error, quantised.getMaxError() + 1e-12);
+  EXPECT_LE(quantised.getMaxError(), 1e-4);
+}
+
+/**
+ * @brief Test quantised evaluation against the decoded spline and the memory
+ * reduction.
+ *
+ */
+TEST_F(QuantisedSplineTest, DecodeO4) {
+  const QuantisedSpline quantised{m_splineO4};
+  const Spline decoded{quantised.toSpline()};
+
+  expectAllClose(quantised(m_points), decoded(m_points), 1e-12);
+
+  const size_t bytesSpline{(m_splineO4.getCoefficients().size() +
+                            m_basisO4->knots().size()) *
+                           sizeof(double)};
+  EXPECT_LT(quantised.getBytes(), bytesSpline);
+}
+
+/**
+ * @brief Test the decoded spline keeps the basis scale, such that derivatives
+ * and integrals coincide with the original spline.
+ *
+ */
+TEST_F(QuantisedSplineTest, DecodeScaled) {
+  const std::shared_ptr<Basis> basis{std::make_shared<Basis>(
+      Eigen::ArrayXd{{0.0, 0.0, 0.0, 0.5, 1.0, 1.0, 1.0}}, 3, 2.0)};
+  const Spline spline{basis, Eigen::MatrixXd::Random(basis->dim(), 2)};
+  const Spline decoded{QuantisedSpline{spline}.toSpline()};
+
+  EXPECT_EQ(decoded.basis()->getScale(), 2.0);
+  expectAllClose(decoded.derivative()(m_points),
+                 spline.derivative()(m_points), 1e-4);
+  expectAllClose(decoded.integral()(m_points), spline.integral()(m_points),
+                 1e-4);
+}
+
+/**
+ * @brief Test quantisation of constant coefficients and offset knots.
+ *
+ */
+TEST_F(QuantisedSplineTest, ConstantOffsetO3) {
+  const std::shared_ptr<Basis> basis{std::make_shared<Basis>(
+      Eigen::ArrayXd{{100.0, 100.0, 100.0, 100.5, 101.0, 101.0, 101.0}}, 3)};
+  const Spline spline{basis, Eigen::MatrixXd::Constant(basis->dim(), 1, 2.5)};
+  const QuantisedSpline quantised{spline};
+
+  const Eigen::ArrayXd points{Eigen::ArrayXd::LinSpaced(11, 100.0, 101.0)};
+  expectAllClose(quantised(points), spline(points), 1e-12);
+
+  // points outside the domain evaluate to zero
+  const Eigen::ArrayXd pointsOut{{99.0, 102.0}};
+  EXPECT_TRUE((quantised(pointsOut) == 0.0).all());
+}
+
+}; // namespace Internal
+}; // namespace BasisSplines
+
+int main(int argc, char **argv) {
+  std::srand(0);
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,151 @@
+#include <Eigen/Core>
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "basisSplines/basis.h"
+#include "basisSplines/rationalSpline.h"
+#include "basisSplines/spline.h"
+#include "testBase.h"
+
+namespace BasisSplines {
+namespace Internal {
+class RationalSplineTest : public TestBase {
+protected:
+  // quarter circle as rational spline of order 3
+  std::shared_ptr<Basis> m_basisO3{std::make_shared<Basis>(
+      Eigen::ArrayXd{{0.0, 0.0, 0.0, 1.0, 1.0, 1.0}}, 3)};
+  const RationalSpline m_circle{m_basisO3,
+                                Eigen::MatrixXd{{1.0, 0.0}, {1.0, 1.0}, {0.0, 1.0}},
+                                Eigen::VectorXd{{1.0, std::sqrt(0.5), 1.0}}};
+
+  const Eigen::ArrayXd m_points{Eigen::ArrayXd::LinSpaced(101, 0.0, 1.0)};
+};
+
+/**
+ * @brief Test evaluation of a quarter circle.
+ *
+ */
+TEST_F(RationalSplineTest, EvalCircle) {
+  const Eigen::ArrayXXd values{m_circle(m_points)};
+
+  const Eigen::ArrayXd radiiEst{values.matrix().rowwise().norm()};
+  expectAllClose(radiiEst, Eigen::ArrayXd::Ones(m_points.size()).eval(),
+                 1e-12);
+
+  // control points and weights are recovered
+  expectAllClose(Eigen::ArrayXXd{m_circle.getControlPoints()},
+                 Eigen::ArrayXXd{{1.0, 0.0}, {1.0, 1.0}, {0.0, 1.0}}, 1e-12);
+}
+
+/**
+ * @brief Test first and second derivative of a quarter circle against finite
+ * differences.
+ *
+ */
+TEST_F(RationalSplineTest, DerivCircle) {
+  const Eigen::ArrayXd points{Eigen::ArrayXd::LinSpaced(11, 0.1, 0.9)};
+  const double step{1e-5};
+
+  const Eigen::ArrayXXd derivGtr{
+      (m_circle(points + step) - m_circle(points - step)) / (2 * step)};
+  expectAllClose(m_circle.derivative(points), derivGtr, 1e-8);
+
+  const Eigen::ArrayXXd dderivGtr{(m_circle.derivative(points + step) -
+                                   m_circle.derivative(points - step)) /
+                                  (2 * step)};
+  expectAllClose(m_circle.derivative(points, 2), dderivGtr, 1e-6);
+
+  // tangent is orthogonal to radius
+  const Eigen::ArrayXd dots{
+      (m_circle(points) * m_circle.derivative(points)).rowwise().sum()};
+  expectAllClose(dots, Eigen::ArrayXd::Zero(points.size()).eval(), 1e-12);
+}
+
+/**
+ * @brief Test knot insertion preserves the quarter circle.
+ *
+ */
+TEST_F(RationalSplineTest, InsertKnotsCircle) {
+  const RationalSpline inserted{m_circle.insertKnots({{0.3, 0.5, 0.5}})};
+
+  EXPECT_EQ(inserted.basis()->dim(), m_basisO3->dim() + 3);
+  expectAllClose(inserted(m_points), m_circle(m_points), 1e-12);
+}
+
+/**
+ * @brief Test rational spline with unit weights equals the polynomial spline.
+ *
+ */
+TEST_F(RationalSplineTest, UnitWeights) {
+  const Eigen::MatrixXd controlPoints{
+      Eigen::MatrixXd::Random(m_basisO3->dim(), 2)};
+  const RationalSpline rational{m_basisO3, controlPoints,
+                                Eigen::VectorXd::Ones(m_basisO3->dim())};
+  const Spline spline{m_basisO3, controlPoints};
+
+  expectAllClose(rational(m_points), spline(m_points), 1e-12);
+  expectAllClose(rational.derivative(m_points),
+                 spline.derivative()(m_points), 1e-12);
+}
+
+/**
+ * @brief Test derivatives of a random rational spline on a scaled basis
+ * against the quotient rule on the homogeneous derivative splines.
+ *
+ */
+TEST_F(RationalSplineTest, DerivScaled) {
+  const std::shared_ptr<Basis> basis{std::make_shared<Basis>(
+      Eigen::ArrayXd{{0.0, 0.0, 0.0, 0.0, 0.2, 0.5, 0.7, 1.0, 1.0, 1.0, 1.0}},
+      4, 2.0)};
+  const RationalSpline rational{
+      basis, Eigen::MatrixXd::Random(basis->dim(), 2),
+      Eigen::VectorXd{Eigen::VectorXd::Random(basis->dim()).array() + 1.5}};
+
+  const Eigen::ArrayXd weights{rational.homogeneous()(m_points).col(2)};
+  std::vector<Eigen::ArrayXXd> derivsGtr{rational(m_points)};
+  for (int orderDer{1}; orderDer < basis->order(); ++orderDer) {
+    // quotient rule on homogeneous derivative splines
+    const Eigen::ArrayXXd homDeriv{
+        rational.homogeneous().derivative(orderDer)(m_points)};
+    Eigen::ArrayXXd derivGtr{homDeriv.leftCols(2)};
+    double binom{1.0};
+    for (int cTerm{1}; cTerm <= orderDer; ++cTerm) {
+      binom = binom * (orderDer - cTerm + 1) / cTerm;
+      derivGtr -=
+          binom * (derivsGtr[orderDer - cTerm].colwise() *
+                   rational.homogeneous().derivative(cTerm)(m_points).col(2));
+    }
+    derivsGtr.push_back(derivGtr.colwise() / weights);
+
+    expectAllClose(rational.derivative(m_points, orderDer),
+                   derivsGtr.back(), 1e-8);
+  }
+}
+
+/**
+ * @brief Test derivatives follow a modification of the basis after
+ * construction.
+ *
+ */
+TEST_F(RationalSplineTest, DerivModifiedBasis) {
+  const std::shared_ptr<Basis> basis{std::make_shared<Basis>(*m_basisO3)};
+  const RationalSpline rational{basis, m_circle.getControlPoints(),
+                                m_circle.getWeights()};
+  rational.basis()->setScale(2.0);
+
+  const RationalSpline rationalGtr{std::make_shared<Basis>(*basis),
+                                   m_circle.getControlPoints(),
+                                   m_circle.getWeights()};
+  for (int orderDer{1}; orderDer <= 3; ++orderDer)
+    expectAllClose(rational.derivative(m_points, orderDer),
+                   rationalGtr.derivative(m_points, orderDer), 1e-12);
+}
+
+}; // namespace Internal
+}; // namespace BasisSplines
+
+int main(int argc, char **argv) {
+  std::srand(0);
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,75 @@
+#include <Eigen/Core>
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+#include "basisSplines/basis.h"
+#include "basisSplines/smallSpline.h"
+#include "basisSplines/spline.h"
+#include "testBase.h"
+
+namespace BasisSplines {
+namespace Internal {
+class SmallSplineTest : public TestBase {
+protected:
+  const std::shared_ptr<Basis> m_basisO4{std::make_shared<Basis>(
+      Eigen::ArrayXd{{0.0, 0.0, 0.0, 0.0, 0.3, 0.5, 0.5, 1.0, 1.0, 1.0, 1.0}},
+      4, 2.0)};
+  const Spline m_spline{m_basisO4,
+                        Eigen::MatrixXd::Random(m_basisO4->dim(), 3)};
+  const Eigen::ArrayXd m_points{Eigen::ArrayXd::LinSpaced(101, 0.0, 1.0)};
+};
+
+/**
+ * @brief Test conversion between small and regular bases and splines.
+ *
+ */
+TEST_F(SmallSplineTest, ConvertSpline) {
+  const SmallBasis basis{*m_basisO4};
+  EXPECT_EQ(basis.toBasis(), *m_basisO4);
+  EXPECT_EQ(basis.dim(), m_basisO4->dim());
+
+  const SmallSpline spline{m_spline};
+  const Spline converted{spline.toSpline()};
+  EXPECT_EQ(*converted.basis(), *m_basisO4);
+  expectAllClose(Eigen::ArrayXXd{converted.getCoefficients()},
+                 Eigen::ArrayXXd{m_spline.getCoefficients()}, 1e-12);
+}
+
+/**
+ * @brief Test evaluation and differentiation coincide with Spline.
+ *
+ */
+TEST_F(SmallSplineTest, EvalDerivative) {
+  const SmallSpline spline{m_spline};
+  expectAllClose(spline(m_points), m_spline(m_points), 1e-12);
+
+  // points outside the knots evaluate to zero
+  EXPECT_TRUE((spline(1.5).array() == 0.0).all());
+
+  for (int order{1}; order < 4; ++order)
+    expectAllClose(spline.derivative(order)(m_points),
+                   m_spline.derivative(order)(m_points), 1e-10);
+}
+
+/**
+ * @brief Test splines exceeding the inline capacity are rejected.
+ *
+ */
+TEST_F(SmallSplineTest, ExceedCapacity) {
+  const Basis basis{Eigen::ArrayXd::LinSpaced(SmallBasis::maxKnots + 1, 0, 1),
+                    2};
+  EXPECT_THROW(SmallBasis{basis}, std::invalid_argument);
+
+  const Spline spline{m_basisO4, Eigen::MatrixXd::Random(
+                                     m_basisO4->dim(), SmallSpline::maxDim + 1)};
+  EXPECT_THROW(SmallSpline{spline}, std::invalid_argument);
+}
+
+}; // namespace Internal
+}; // namespace BasisSplines
+
+int main(int argc, char **argv) {
+  std::srand(0);
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
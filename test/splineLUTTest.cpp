@@ -0,0 +1,131 @@
+#include <Eigen/Core>
+#include <gtest/gtest.h>
+
+#include "basisSplines/basis.h"
+#include "basisSplines/spline.h"
+#include "basisSplines/splineLUT.h"
+#include "testBase.h"
+
+namespace BasisSplines {
+namespace Internal {
+class SplineLUTTest : public TestBase {
+protected:
+  const std::shared_ptr<Basis> m_basisO4{std::make_shared<Basis>(
+      Eigen::ArrayXd{{0.0, 0.0, 0.0, 0.0, 0.3, 0.5, 0.8, 1.0, 1.0, 1.0, 1.0}},
+      4)};
+  const Spline m_splineO4{m_basisO4,
+                          Eigen::MatrixXd::Random(m_basisO4->dim(), 2)};
+
+  const Eigen::ArrayXd m_points{Eigen::ArrayXd::Random(10000) * 0.5 + 0.5};
+
+  /**
+   * @brief Determine the maximum absolute difference between lookup table
+   * and spline at "m_points".
+   *
+   * @param lut lookup table.
+   * @param spline approximated spline.
+   * @return double maximum approximation error.
+   */
+  double maxError(const SplineLUT &lut, const Spline &spline) const {
+    return (lut(m_points) - spline(m_points)).abs().maxCoeff();
+  }
+};
+
+/**
+ * @brief Test linear lookup table of an order 4 spline against its tolerance.
+ *
+ */
+TEST_F(SplineLUTTest, LinearO4) {
+  for (double tolerance : {1e-2, 1e-4, 1e-6}) {
+    const SplineLUT lut{m_splineO4, tolerance};
+    EXPECT_LE(lut.getErrorBound(), tolerance);
+    EXPECT_LE(maxError(lut, m_splineO4), lut.getErrorBound());
+  }
+}
+
+/**
+ * @brief Test cubic Hermite lookup table of an order 4 spline against its
+ * tolerance and against the size of the linear lookup table.
+ *
+ */
+TEST_F(SplineLUTTest, CubicO4) {
+  for (double tolerance : {1e-2, 1e-4, 1e-6}) {
+    const SplineLUT lut{m_splineO4, tolerance, true};
+    EXPECT_LE(lut.getErrorBound(), tolerance);
+    EXPECT_LE(maxError(lut, m_splineO4), lut.getErrorBound());
+    EXPECT_LT(lut.getNumIntervals(),
+              SplineLUT(m_splineO4, tolerance).getNumIntervals());
+  }
+}
+
+/**
+ * @brief Test lookup tables of a scaled spline with a kink, whose error bounds
+ * use lower derivatives.
+ *
+ */
+TEST_F(SplineLUTTest, KinkScaledO3) {
+  const std::shared_ptr<Basis> basis{std::make_shared<Basis>(
+      Eigen::ArrayXd{{0.0, 0.0, 0.0, 0.4, 0.4, 1.0, 1.0, 1.0}}, 3, 2.0)};
+  const Spline spline{basis, Eigen::MatrixXd::Random(basis->dim(), 1)};
+
+  for (bool cubic : {false, true}) {
+    const SplineLUT lut{spline, 1e-4, cubic};
+    EXPECT_LE(maxError(lut, spline), lut.getErrorBound());
+  }
+}
+
+/**
+ * @brief Test lookup tables of a smooth spline with scale below one, whose
+ * error bounds use derivatives of order two and four.
+ *
+ */
+TEST_F(SplineLUTTest, SmoothScaledO4) {
+  const std::shared_ptr<Basis> basis{std::make_shared<Basis>(
+      Eigen::ArrayXd{{0.0, 0.0, 0.0, 0.0, 0.3, 0.6, 1.0, 1.0, 1.0, 1.0}}, 4,
+      0.1)};
+  const Spline spline{basis, Eigen::MatrixXd::Random(basis->dim(), 2)};
+
+  for (bool cubic : {false, true}) {
+    const SplineLUT lut{spline, 1e-4, cubic};
+    EXPECT_LE(maxError(lut, spline), lut.getErrorBound());
+    EXPECT_LE(lut.getErrorBound(), 1e-4);
+  }
+}
+
+/**
+ * @brief Test exact reproduction of a linear spline and the clamping of
+ * points outside the domain.
+ *
+ */
+TEST_F(SplineLUTTest, LinearExact) {
+  const std::shared_ptr<Basis> basis{
+      std::make_shared<Basis>(Eigen::ArrayXd{{0.0, 0.0, 1.0, 1.0}}, 2)};
+  const Spline spline{basis, Eigen::MatrixXd{{1.0}, {3.0}}};
+  const SplineLUT lut{spline, 1e-12};
+
+  EXPECT_EQ(lut.getNumIntervals(), 1);
+  EXPECT_NEAR(lut(0.25), 1.5, 1e-14);
+  EXPECT_NEAR(lut(-1.0), 1.0, 1e-14);
+  EXPECT_NEAR(lut(2.0), 3.0, 1e-14);
+}
+
+/**
+ * @brief Test rejection of discontinuous splines.
+ *
+ */
+TEST_F(SplineLUTTest, Discontinuous) {
+  const std::shared_ptr<Basis> basis{std::make_shared<Basis>(
+      Eigen::ArrayXd{{0.0, 0.0, 0.5, 0.5, 1.0, 1.0}}, 2)};
+  const Spline spline{basis, Eigen::MatrixXd::Random(basis->dim(), 1)};
+
+  EXPECT_THROW(SplineLUT(spline, 1e-3), std::invalid_argument);
+}
+
+}; // namespace Internal
+}; // namespace BasisSplines
+
+int main(int argc, char **argv) {
+  std::srand(0);
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
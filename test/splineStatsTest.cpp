@@ -0,0 +1,143 @@
+#include <Eigen/Core>
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+#include "basisSplines/basis.h"
+#include "basisSplines/interpolate.h"
+#include "basisSplines/spline.h"
+#include "basisSplines/splineStats.h"
+#include "testBase.h"
+
+namespace BasisSplines {
+namespace Internal {
+class SplineStatsTest : public TestBase {
+protected:
+  const std::shared_ptr<Basis> m_basisO2{std::make_shared<Basis>(
+      Eigen::ArrayXd{{0.0, 0.0, 0.5, 1.0, 1.0}}, 2)};
+  const std::shared_ptr<Basis> m_basisO4{std::make_shared<Basis>(
+      Eigen::ArrayXd{{0.0, 0.0, 0.0, 0.0, 0.1, 0.3, 0.4, 0.6, 0.8, 1.0, 1.0,
+                      1.0, 1.0}},
+      4)};
+
+  /** spline t and 1 - t */
+  const Spline m_splineLin{m_basisO2,
+                           Eigen::MatrixXd{{0.0, 1.0}, {0.5, 0.5}, {1.0, 0.0}}};
+  const Spline m_splineO4{m_basisO4,
+                          Eigen::MatrixXd::Random(m_basisO4->dim(), 2)};
+
+  const Eigen::ArrayXd m_begins{{0.0, 0.2, 0.35, 0.9}};
+  const Eigen::ArrayXd m_ends{{1.0, 0.6, 0.45, 1.0}};
+};
+
+/**
+ * @brief Test statistics of linear splines over windows.
+ *
+ */
+TEST_F(SplineStatsTest, Linear) {
+  const SplineStats stats{m_splineLin};
+  const Eigen::ArrayXd begins{{0.2}};
+  const Eigen::ArrayXd ends{{0.6}};
+
+  expectAllClose(stats.integral(begins, ends), Eigen::ArrayXXd{{0.16, 0.24}},
+                 1e-12);
+  expectAllClose(stats.mean(begins, ends), Eigen::ArrayXXd{{0.4, 0.6}}, 1e-12);
+  expectAllClose(stats.variance(begins, ends),
+                 Eigen::ArrayXXd{{0.16 / 12, 0.16 / 12}}, 1e-12);
+  expectAllClose(stats.rms(begins, ends),
+                 Eigen::ArrayXXd{{std::sqrt(0.52 / 3), std::sqrt(1.12 / 3)}},
+                 1e-12);
+  expectAllClose(stats.timeAbove(0.5, begins, ends),
+                 Eigen::ArrayXXd{{0.1, 0.3}}, 1e-12);
+}
+
+/**
+ * @brief Test statistics of a random spline coincide with sampled statistics
+ * for several windows.
+ *
+ */
+TEST_F(SplineStatsTest, Sampled) {
+  const SplineStats stats{m_splineO4};
+  const Eigen::ArrayXXd means{stats.mean(m_begins, m_ends)};
+  const Eigen::ArrayXXd variances{stats.variance(m_begins, m_ends)};
+  const Eigen::ArrayXXd rms{stats.rms(m_begins, m_ends)};
+  const Eigen::ArrayXXd durations{stats.timeAbove(0.1, m_begins, m_ends)};
+
+  for (Eigen::Index cWin{}; cWin < m_begins.size(); ++cWin) {
+    // midpoint rule on a fine grid
+    const int numSamples{100000};
+    const double step{(m_ends(cWin) - m_begins(cWin)) / numSamples};
+    const Eigen::ArrayXd points{Eigen::ArrayXd::LinSpaced(
+        numSamples, m_begins(cWin) + 0.5 * step, m_ends(cWin) - 0.5 * step)};
+    const Eigen::ArrayXXd values{m_splineO4(points)};
+
+    const Eigen::ArrayXd meansGtr{values.colwise().mean().transpose()};
+    expectAllClose(Eigen::ArrayXd{means.row(cWin).transpose()}, meansGtr,
+                   1e-8);
+    expectAllClose(
+        Eigen::ArrayXd{variances.row(cWin).transpose()},
+        Eigen::ArrayXd{(values.rowwise() - meansGtr.transpose())
+                           .square()
+                           .colwise()
+                           .mean()
+                           .transpose()},
+        1e-8);
+    expectAllClose(
+        Eigen::ArrayXd{rms.row(cWin).transpose()},
+        Eigen::ArrayXd{values.square().colwise().mean().sqrt().transpose()},
+        1e-8);
+    expectAllClose(
+        Eigen::ArrayXd{durations.row(cWin).transpose()},
+        Eigen::ArrayXd{
+            (values > 0.1).cast<double>().colwise().sum().transpose() * step},
+        1e-4);
+  }
+}
+
+/**
+ * @brief Test statistics of linear splines with a scaled basis. Means are
+ * independent of the scale, integrals and durations scale with it.
+ *
+ */
+TEST_F(SplineStatsTest, Scaled) {
+  const std::shared_ptr<Basis> basis{std::make_shared<Basis>(
+      Eigen::ArrayXd{{0.0, 0.0, 0.5, 1.0, 1.0}}, 2, 2.0)};
+  const SplineStats stats{{basis, m_splineLin.getCoefficients()}};
+  const Eigen::ArrayXd begins{{0.2}};
+  const Eigen::ArrayXd ends{{0.6}};
+
+  expectAllClose(stats.integral(begins, ends), Eigen::ArrayXXd{{0.32, 0.48}},
+                 1e-12);
+  expectAllClose(stats.mean(begins, ends), Eigen::ArrayXXd{{0.4, 0.6}}, 1e-12);
+  expectAllClose(Eigen::ArrayXXd{stats.meanSquare(begins, ends) -
+                                 stats.mean(begins, ends).square()},
+                 Eigen::ArrayXXd{{0.16 / 12, 0.16 / 12}}, 1e-12);
+  expectAllClose(stats.timeAbove(0.5, begins, ends),
+                 Eigen::ArrayXXd{{0.2, 0.6}}, 1e-12);
+}
+
+/**
+ * @brief Test invalid windows are rejected.
+ *
+ */
+TEST_F(SplineStatsTest, InvalidWindows) {
+  const SplineStats stats{m_splineLin};
+  EXPECT_THROW(stats.mean(Eigen::ArrayXd{{0.5}}, Eigen::ArrayXd{{0.2}}),
+               std::invalid_argument);
+  EXPECT_THROW(stats.mean(Eigen::ArrayXd{{-0.5}}, Eigen::ArrayXd{{0.2}}),
+               std::invalid_argument);
+  EXPECT_THROW(stats.timeAbove(0.0, Eigen::ArrayXd{{0.5}},
+                               Eigen::ArrayXd{{1.5}}),
+               std::invalid_argument);
+  EXPECT_THROW(stats.integral(Eigen::ArrayXd{{0.1, 0.2}},
+                              Eigen::ArrayXd{{0.3}}),
+               std::invalid_argument);
+}
+
+}; // namespace Internal
+}; // namespace BasisSplines
+
+int main(int argc, char **argv) {
+  std::srand(0);
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -358,6 +358,41 @@ TEST_F(SplineTest, ZerosRightSplineO3) {
     expectAllClose(valueEst, valuesGtr, 1e-6);
 }
 
+/**
+ * @brief Test getting a trivial root at a zero coefficient followed by a root
+ * between sign-changing coefficients of a piecewise linear spline.
+ *
+ */
+TEST_F(SplineTest, ZerosTrivialAndEstimated) {
+  const Spline spline{m_basisO2, Eigen::MatrixXd{{0.0}, {1.0}, {-1.0}}};
+  const Eigen::ArrayXd valuesEst{spline.getRoots()[0]};
+  const Eigen::ArrayXd valuesGtr{{0.0, 0.75}};
+
+  expectAllClose(valuesEst, valuesGtr, 1e-6);
+}
+
+/**
+ * @brief Test sign changes of the coefficients vanishing during the refinement
+ * of a 4th order spline with a single root and of a 3rd order polynomial
+ * without root.
+ *
+ */
+TEST_F(SplineTest, ZerosVanishingSignChange) {
+  const std::shared_ptr<Basis> basisO4{std::make_shared<Basis>(
+      Eigen::ArrayXd{{0.0, 0.0, 0.0, 0.0, 0.5, 1.0, 1.0, 1.0, 1.0}}, 4)};
+  const Spline splineO4{basisO4,
+                        Eigen::MatrixXd{{0.4}, {-0.9}, {0.2}, {-0.8}, {-0.1}}};
+  const Eigen::ArrayXd rootsO4{splineO4.getRoots()[0]};
+  ASSERT_EQ(rootsO4.size(), 1);
+  expectAllClose(Eigen::ArrayXXd{splineO4(rootsO4)},
+                 Eigen::ArrayXXd{Eigen::ArrayXXd::Zero(1, 1)}, 1e-6);
+
+  const std::shared_ptr<Basis> basisO3{std::make_shared<Basis>(
+      Eigen::ArrayXd{{0.0, 0.0, 0.0, 1.0, 1.0, 1.0}}, 3)};
+  const Spline splineO3{basisO3, Eigen::MatrixXd{{-0.2}, {0.2}, {-0.5}}};
+  EXPECT_EQ(splineO3.getRoots()[0].size(), 0);
+}
+
 /**
  * @brief Test getting all zeros of a 3rd order spline with random coefficients.
  *
@@ -375,6 +410,391 @@ TEST_F(SplineTest, ZerosSplineO3Rand) {
   }
 }
 
+/**
+ * @brief Test Bezier control points of each polynomial piece of a spline of
+ * order 3 by evaluating the Bezier curves.
+ *
+ */
+TEST_F(SplineTest, BezierO3) {
+  const Eigen::ArrayXd &knots{m_basisO3Seg3->knots()};
+  const Eigen::ArrayXd params{Eigen::ArrayXd::LinSpaced(11, 0.0, 1.0)};
+
+  for (int span{m_basisO3Seg3->order() - 1}; span < m_basisO3Seg3->dim();
+       ++span) {
+    if (knots(span) >= knots(span + 1))
+      continue;
+
+    const Eigen::MatrixXd controlPoints{m_splineO3Seg3.getBezier(span)};
+    const Eigen::ArrayXd points{knots(span) +
+                                params * (knots(span + 1) - knots(span))};
+
+    Eigen::ArrayXXd valuesEst(points.size(), m_splineO3Seg3.dim());
+    for (int cPoint{}; cPoint < points.size(); ++cPoint)
+      valuesEst.row(cPoint) =
+          deCasteljau(controlPoints, params(cPoint)).transpose().array();
+    const Eigen::ArrayXXd valuesGtr{m_splineO3Seg3(points)};
+
+    expectAllClose(valuesEst, valuesGtr, 1e-10);
+  }
+}
+
+/**
+ * @brief Test flattening a linear function represented by a spline of order 3.
+ * The polyline consists of the breakpoints.
+ *
+ */
+TEST_F(SplineTest, FlattenLinear) {
+  const Spline spline{m_basisO3Seg3,
+                      Interpolate{m_basisO3Seg3}.fit(
+                          [](const Eigen::ArrayXd &points) {
+                            return Eigen::MatrixXd{2.0 * points - 1.0};
+                          })};
+
+  std::vector<double> pointsEst{};
+  spline.flatten(1e-6, [&](double point, const Eigen::VectorXd &) {
+    pointsEst.push_back(point);
+  });
+
+  const Eigen::ArrayXd valuesEst{
+      Eigen::Map<Eigen::ArrayXd>(pointsEst.data(), pointsEst.size())};
+  const Eigen::ArrayXd valuesGtr{m_basisO3Seg3->getBreakpoints().first};
+
+  ASSERT_EQ(valuesEst.size(), valuesGtr.size());
+  expectAllClose(valuesEst, valuesGtr, 1e-10);
+}
+
+/**
+ * @brief Test distance between a spline of order 3 and its flattened polyline.
+ *
+ */
+TEST_F(SplineTest, FlattenTolerance) {
+  const double tolerance{1e-3};
+
+  std::vector<double> vertices{};
+  std::vector<Eigen::VectorXd> values{};
+  m_splineO3Seg3.flatten(tolerance,
+                         [&](double point, const Eigen::VectorXd &value) {
+                           vertices.push_back(point);
+                           values.push_back(value);
+                         });
+
+  ASSERT_GE(vertices.size(), std::size_t{2});
+
+  // vertices increase and lie on the spline
+  for (std::size_t cVert{}; cVert < vertices.size(); ++cVert) {
+    if (cVert > 0) {
+      EXPECT_LT(vertices[cVert - 1], vertices[cVert]);
+    }
+    expectAllClose(Eigen::ArrayXd{values[cVert].array()},
+                   Eigen::ArrayXd{
+                       m_splineO3Seg3({{vertices[cVert]}}).row(0).transpose()},
+                   1e-10);
+  }
+
+  // linear interpolation between vertices remains close to the spline
+  const Eigen::ArrayXd points{Eigen::ArrayXd::LinSpaced(1001, 0.0, 1.0)};
+  const Eigen::ArrayXXd valuesGtr{m_splineO3Seg3(points)};
+  std::size_t cVert{};
+  for (Eigen::Index cPoint{}; cPoint < points.size(); ++cPoint) {
+    while (cVert + 2 < vertices.size() && vertices[cVert + 1] < points(cPoint))
+      ++cVert;
+    const double param{(points(cPoint) - vertices[cVert]) /
+                       (vertices[cVert + 1] - vertices[cVert])};
+    const Eigen::VectorXd valueEst{(1.0 - param) * values[cVert] +
+                                   param * values[cVert + 1]};
+    EXPECT_LE((valueEst - valuesGtr.row(cPoint).transpose().matrix()).norm(),
+              tolerance);
+  }
+}
+
+/**
+ * @brief Test uniform sampling by forward differencing of a spline of order 4
+ * against pointwise evaluation, including points outside the domain.
+ *
+ */
+TEST_F(SplineTest, SampleUniformO4) {
+  const std::shared_ptr<Basis> basis{std::make_shared<Basis>(
+      Eigen::ArrayXd{{0.0, 0.0, 0.0, 0.0, 0.3, 0.3, 0.7, 1.0, 1.0, 1.0, 1.0}},
+      4)};
+  const Spline spline{basis, Eigen::MatrixXd::Random(basis->dim(), 2)};
+
+  const int count{1201};
+  const double begin{-0.1};
+  const double step{1.2 / (count - 1)};
+
+  const Eigen::ArrayXXd valuesGtr{
+      spline(Eigen::ArrayXd::LinSpaced(count, begin, begin + (count - 1) * step))};
+
+  // test with frequent and rare re-anchoring
+  for (int reanchor : {1, 16, 10000}) {
+    const Eigen::ArrayXXd valuesEst{
+        spline.sampleUniform(begin, step, count, reanchor)};
+    expectAllClose(valuesEst, valuesGtr, 1e-8);
+  }
+}
+
+/**
+ * @brief Test composition of a spline of order 3 with a monotone quadratic
+ * spline.
+ *
+ */
+TEST_F(SplineTest, ComposeO3O3) {
+  const Spline inner{m_basisO3,
+                     Interpolate{m_basisO3}.fit([](const Eigen::ArrayXd &points) {
+                       return Eigen::MatrixXd{points.pow(2)};
+                     })};
+
+  const Spline spline{m_splineO3Seg3.compose(inner)};
+  EXPECT_EQ(spline.basis()->order(), 5);
+
+  const Eigen::ArrayXXd valuesGtr{m_splineO3Seg3(inner(m_points).col(0))};
+  const Eigen::ArrayXXd valuesEst{spline(m_points)};
+
+  expectAllClose(valuesEst, valuesGtr, 1e-8);
+}
+
+/**
+ * @brief Test composition of a spline of order 3 with a piecewise linear
+ * spline. The breakpoints of the composition include the inner breakpoint and
+ * the preimages of the outer breakpoints.
+ *
+ */
+TEST_F(SplineTest, ComposeO3O2) {
+  const Spline inner{m_basisO2, Eigen::VectorXd{{0.0, 0.8, 1.0}}};
+
+  const Spline spline{m_splineO3Seg3.compose(inner)};
+  EXPECT_EQ(spline.basis()->order(), 3);
+
+  const Eigen::ArrayXd bpsGtr{{0.0, 0.25, 0.375, 0.5, 1.0}};
+  expectAllClose(spline.basis()->getBreakpoints().first, bpsGtr, 1e-8);
+
+  const Eigen::ArrayXXd valuesGtr{m_splineO3Seg3(inner(m_points).col(0))};
+  const Eigen::ArrayXXd valuesEst{spline(m_points)};
+
+  expectAllClose(valuesEst, valuesGtr, 1e-8);
+}
+
+/**
+ * @brief Test span-sorted evaluation of unsorted points against dense
+ * evaluation.
+ *
+ */
+TEST_F(SplineTest, EvalSortedRandom) {
+  const Eigen::ArrayXd points{0.6 * Eigen::ArrayXd::Random(1000) + 0.5};
+  const Eigen::ArrayXXd valuesGtr{
+      m_basisO3Seg3->operator()(points) * m_splineO3Seg3.getCoefficients()};
+
+  expectAllClose(m_splineO3Seg3.evalSorted(points), valuesGtr, 1e-12);
+  expectAllClose(m_splineO3Seg3(points), valuesGtr, 1e-12);
+}
+
+/**
+ * @brief Test derivatives and integrals stored in an output spline reuse its
+ * basis and coefficient storage if the structure matches.
+ *
+ */
+TEST_F(SplineTest, DerivativeIntegralInto) {
+  const std::shared_ptr<Basis> basis{std::make_shared<Basis>(
+      Eigen::ArrayXd{{0.0, 0.0, 0.0, 0.0, 0.3, 0.5, 0.5, 1.0, 1.0, 1.0, 1.0}},
+      4, 2.0)};
+  const Spline spline{basis, Eigen::MatrixXd::Random(basis->dim(), 2)};
+
+  for (int order{1}; order < 4; ++order) {
+    Spline deriv{};
+    spline.derivativeInto(deriv, order);
+    const std::shared_ptr<Basis> basisDeriv{deriv.basis()};
+    deriv.setCoefficients(Eigen::MatrixXd::Zero(basisDeriv->dim(), 2));
+    const double *data{deriv.getCoefficients().data()};
+
+    spline.derivativeInto(deriv, order);
+    EXPECT_EQ(deriv.basis(), basisDeriv);
+    EXPECT_EQ(deriv.getCoefficients().data(), data);
+    expectAllClose(deriv(m_points), spline.derivative(order)(m_points), 1e-10);
+  }
+
+  for (int order{1}; order < 3; ++order) {
+    Spline integral{};
+    spline.integralInto(integral, order);
+    const std::shared_ptr<Basis> basisInt{integral.basis()};
+    integral.setCoefficients(Eigen::MatrixXd::Zero(basisInt->dim(), 2));
+
+    spline.integralInto(integral, order);
+    EXPECT_EQ(integral.basis(), basisInt);
+    expectAllClose(integral(m_points), spline.integral(order)(m_points),
+                   1e-10);
+  }
+
+  // output spline with other basis is replaced
+  Spline other{m_splineO3Seg3};
+  spline.derivativeInto(other);
+  expectAllClose(other(m_points), spline.derivative()(m_points), 1e-10);
+}
+
+/**
+ * @brief Test knot insertion stored in an output spline reuses its basis.
+ *
+ */
+TEST_F(SplineTest, InsertKnotInto) {
+  Spline inserted{};
+  m_splineO3Seg3.insertKnotInto(0.3, inserted);
+  const std::shared_ptr<Basis> basis{inserted.basis()};
+  inserted.setCoefficients(Eigen::MatrixXd::Zero(basis->dim(), 2));
+
+  m_splineO3Seg3.insertKnotInto(0.3, inserted);
+  EXPECT_EQ(inserted.basis(), basis);
+  expectAllClose(inserted(m_points), m_splineO3Seg3(m_points), 1e-10);
+
+  m_splineO3Seg3.insertKnotInto(0.7, inserted);
+  EXPECT_NE(inserted.basis(), basis);
+  expectAllClose(inserted(m_points), m_splineO3Seg3(m_points), 1e-10);
+}
+
+/**
+ * @brief Test sums and products stored in an output spline with enabled
+ * transform cache.
+ *
+ */
+TEST_F(SplineTest, AddProdInto) {
+  const Spline splineR{m_basisO2, Eigen::MatrixXd::Random(m_basisO2->dim(), 2)};
+  const Eigen::ArrayXXd valuesSum{m_splineO3Seg3(m_points) +
+                                  splineR(m_points)};
+  const Eigen::ArrayXXd valuesProd{m_splineO3Seg3(m_points) *
+                                   splineR(m_points)};
+  Spline sum{};
+  Spline prod{};
+
+  // without cache the results are assigned
+  m_splineO3Seg3.addInto(splineR, sum);
+  m_splineO3Seg3.prodInto(splineR, prod);
+  expectAllClose(sum(m_points), valuesSum, 1e-10);
+  expectAllClose(prod(m_points), valuesProd, 1e-10);
+
+  TransformCache::global().setCapacity(4);
+  for (int cRep{}; cRep < 2; ++cRep) {
+    m_splineO3Seg3.addInto(splineR, sum);
+    m_splineO3Seg3.prodInto(splineR, prod);
+    expectAllClose(sum(m_points), valuesSum, 1e-10);
+    expectAllClose(prod(m_points), valuesProd, 1e-10);
+  }
+  EXPECT_EQ(TransformCache::global().getHits(), 2);
+  TransformCache::global().setCapacity(0);
+  TransformCache::global().clear();
+}
+
+/**
+ * @brief Test rvalue knots and coefficients are moved into bases and splines
+ * without copying their storage.
+ *
+ */
+TEST_F(SplineTest, MoveStorage) {
+  Eigen::ArrayXd knots{m_basisO3Seg3->knots()};
+  const double *dataKnots{knots.data()};
+  const std::shared_ptr<Basis> basis{
+      std::make_shared<Basis>(std::move(knots), 3)};
+  EXPECT_EQ(basis->knots().data(), dataKnots);
+
+  Eigen::MatrixXd coeffs{Eigen::MatrixXd::Random(basis->dim(), 2)};
+  const Eigen::MatrixXd coeffsGtr{coeffs};
+  const double *dataCoeffs{coeffs.data()};
+  Spline spline{basis, std::move(coeffs)};
+  EXPECT_EQ(spline.getCoefficients().data(), dataCoeffs);
+
+  Eigen::MatrixXd coeffsNew{Eigen::MatrixXd::Random(basis->dim(), 2)};
+  const double *dataCoeffsNew{coeffsNew.data()};
+  spline.setCoefficients(std::move(coeffsNew));
+  EXPECT_EQ(spline.getCoefficients().data(), dataCoeffsNew);
+
+  // coefficients of an expiring spline are moved out
+  const Eigen::MatrixXd coeffsOut{
+      Spline{basis, coeffsGtr}.getCoefficients()};
+  expectAllClose(Eigen::ArrayXXd{coeffsOut}, Eigen::ArrayXXd{coeffsGtr},
+                 1e-12);
+  const Eigen::MatrixXd coeffsMoved{std::move(spline).getCoefficients()};
+  EXPECT_EQ(coeffsMoved.data(), dataCoeffsNew);
+}
+
+/**
+ * @brief Test retimed splines coincide with the original spline at mapped
+ * points and their derivatives and integrals scale with the factor.
+ *
+ */
+TEST_F(SplineTest, Affine) {
+  const double factor{2.5};
+  const double offset{-1.0};
+  const Spline spline{m_splineO3Seg3.affine(factor, offset)};
+  const Eigen::ArrayXd pointsMapped{factor * m_points + offset};
+
+  expectAllClose(spline(pointsMapped), m_splineO3Seg3(m_points), 1e-12);
+  expectAllClose(spline.derivative()(pointsMapped),
+                 Eigen::ArrayXXd{m_splineO3Seg3.derivative()(m_points) /
+                                 factor},
+                 1e-12);
+
+  const Eigen::ArrayXXd integralMapped{spline.integral()(pointsMapped)};
+  const Eigen::ArrayXXd integral{m_splineO3Seg3.integral()(m_points)};
+  expectAllClose(
+      Eigen::ArrayXXd{integralMapped.rowwise() - integralMapped.row(0)},
+      Eigen::ArrayXXd{(integral.rowwise() - integral.row(0)) * factor},
+      1e-12);
+
+  // coefficients of an expiring spline are moved into the retimed spline
+  Spline splineMoved{m_splineO3Seg3};
+  const double *dataCoeffs{splineMoved.getCoefficients().data()};
+  const Spline splineMapped{std::move(splineMoved).affine(factor, offset)};
+  EXPECT_EQ(splineMapped.getCoefficients().data(), dataCoeffs);
+}
+
+/**
+ * @brief Test sums of splines retimed by the same map keep the common basis.
+ *
+ */
+TEST_F(SplineTest, AffineAdd) {
+  const Spline splineL{m_splineO3Seg3.affine(2.0, 1.0)};
+  const Spline splineR{
+      Spline{m_basisO3Seg3, Eigen::MatrixXd::Random(m_basisO3Seg3->dim(), 2)}
+          .affine(2.0, 1.0)};
+  const Eigen::ArrayXd points{2.0 * m_points + 1.0};
+
+  const Spline spline{splineL.add(splineR)};
+  EXPECT_TRUE(*spline.basis() == *splineL.basis());
+  expectAllClose(spline(points),
+                 Eigen::ArrayXXd{splineL(points) + splineR(points)}, 1e-12);
+
+  Spline out{};
+  splineL.addInto(splineR, out);
+  EXPECT_EQ(out.basis(), splineL.basis());
+  expectAllClose(out(points), spline(points), 1e-12);
+}
+
+/**
+ * @brief Test evaluation, derivative and roots of selected output dimensions
+ * coincide with the columns of all output dimensions.
+ *
+ */
+TEST_F(SplineTest, SelectDims) {
+  const Spline spline{m_basisO3Seg3,
+                      Eigen::MatrixXd::Random(m_basisO3Seg3->dim(), 5)};
+  const Eigen::ArrayXi dims{{3, 0, 3}};
+
+  const Spline splineSel{spline.select(dims)};
+  EXPECT_EQ(splineSel.dim(), 3);
+  EXPECT_EQ(splineSel.basis(), spline.basis());
+
+  const Eigen::ArrayXXd values{spline(m_points)};
+  expectAllClose(spline(m_points, dims),
+                 Eigen::ArrayXXd{values(Eigen::all, dims)}, 1e-14);
+
+  const Eigen::ArrayXXd valuesDer{spline.derivative(2)(m_points)};
+  expectAllClose(spline.derivative(dims, 2)(m_points),
+                 Eigen::ArrayXXd{valuesDer(Eigen::all, dims)}, 1e-12);
+
+  const std::vector<Eigen::ArrayXd> roots{spline.getRoots()};
+  const std::vector<Eigen::ArrayXd> rootsSel{spline.getRoots(dims)};
+  ASSERT_EQ(rootsSel.size(), dims.size());
+  for (Eigen::Index cDim{}; cDim < dims.size(); ++cDim)
+    expectAllClose(rootsSel[cDim], roots[dims(cDim)], 1e-14);
+}
+
 }; // namespace Internal
 }; // namespace BasisSplines
 
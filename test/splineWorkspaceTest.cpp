@@ -0,0 +1,105 @@
+#include <Eigen/Core>
+#include <gtest/gtest.h>
+#include <memory_resource>
+#include <thread>
+
+#include "basisSplines/basis.h"
+#include "basisSplines/quantisedSpline.h"
+#include "basisSplines/spline.h"
+#include "basisSplines/splineWorkspace.h"
+#include "testBase.h"
+
+namespace BasisSplines {
+namespace Internal {
+class SplineWorkspaceTest : public TestBase {
+protected:
+  const std::shared_ptr<Basis> m_basisO3{std::make_shared<Basis>(
+      Eigen::ArrayXd{{0.0, 0.0, 0.0, 0.4, 0.6, 1.0, 1.0, 1.0}}, 3)};
+  const std::shared_ptr<Basis> m_basisO4{std::make_shared<Basis>(
+      Eigen::ArrayXd{{0.0, 0.0, 0.0, 0.0, 0.3, 0.5, 0.5, 1.0, 1.0, 1.0, 1.0}},
+      4)};
+  const Spline m_splineO3{m_basisO3,
+                          Eigen::MatrixXd::Random(m_basisO3->dim(), 2)};
+  const Spline m_splineO4{m_basisO4,
+                          Eigen::MatrixXd::Random(m_basisO4->dim(), 2)};
+  const Eigen::ArrayXd m_points{0.5 * Eigen::ArrayXd::Random(101) + 0.5};
+};
+
+/**
+ * @brief Test the workspace resource is installed for the scope of the
+ * innermost workspace and only on the creating thread.
+ *
+ */
+TEST_F(SplineWorkspaceTest, ScopeNested) {
+  std::pmr::memory_resource *const heap{SplineWorkspace::resource()};
+  EXPECT_EQ(heap, std::pmr::get_default_resource());
+
+  {
+    SplineWorkspace outer{};
+    std::pmr::memory_resource *const resourceOuter{
+        SplineWorkspace::resource()};
+    EXPECT_NE(resourceOuter, heap);
+
+    {
+      SplineWorkspace inner{};
+      EXPECT_NE(SplineWorkspace::resource(), resourceOuter);
+      EXPECT_NE(SplineWorkspace::resource(), heap);
+    }
+    EXPECT_EQ(SplineWorkspace::resource(), resourceOuter);
+
+    std::pmr::memory_resource *resourceThread{};
+    std::thread{[&resourceThread]() {
+      resourceThread = SplineWorkspace::resource();
+    }}.join();
+    EXPECT_EQ(resourceThread, heap);
+  }
+  EXPECT_EQ(SplineWorkspace::resource(), heap);
+}
+
+/**
+ * @brief Test spline operations in a workspace coincide with operations
+ * using heap scratch buffers.
+ *
+ */
+TEST_F(SplineWorkspaceTest, OperationsEqual) {
+  const Eigen::ArrayXXd basisValues{(*m_basisO4)(m_points)};
+  const Eigen::ArrayXXd values{m_splineO4.evalSorted(m_points)};
+  const Spline chain{m_splineO3.prod(m_splineO4).derivative().integral()};
+  const QuantisedSpline quantised{m_splineO4};
+  const Eigen::ArrayXXd valuesQuantised{quantised(m_points)};
+
+  SplineWorkspace workspace{};
+  expectAllClose(Eigen::ArrayXXd{(*m_basisO4)(m_points)}, basisValues, 1e-12);
+  expectAllClose(m_splineO4.evalSorted(m_points), values, 1e-12);
+  expectAllClose(
+      m_splineO3.prod(m_splineO4).derivative().integral()(m_points),
+      chain(m_points), 1e-12);
+  expectAllClose(quantised(m_points), valuesQuantised, 1e-12);
+}
+
+/**
+ * @brief Test results of operations in a workspace remain valid after the
+ * workspace is destroyed.
+ *
+ */
+TEST_F(SplineWorkspaceTest, ResultsOutliveScope) {
+  Spline deriv{};
+  Eigen::ArrayXXd values{};
+  {
+    SplineWorkspace workspace{};
+    deriv = m_splineO4.derivative();
+    values = m_splineO4(m_points);
+  }
+
+  expectAllClose(deriv(m_points), m_splineO4.derivative()(m_points), 1e-12);
+  expectAllClose(values, m_splineO4(m_points), 1e-12);
+}
+
+}; // namespace Internal
+}; // namespace BasisSplines
+
+int main(int argc, char **argv) {
+  std::srand(0);
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
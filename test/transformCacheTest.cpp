@@ -0,0 +1,208 @@
+#include <Eigen/Core>
+#include <gtest/gtest.h>
+
+#include "basisSplines/basis.h"
+#include "basisSplines/basisPool.h"
+#include "basisSplines/spline.h"
+#include "basisSplines/transformCache.h"
+#include "testBase.h"
+
+namespace BasisSplines {
+namespace Internal {
+class TransformCacheTest : public TestBase {
+protected:
+  const std::shared_ptr<Basis> m_basisL{std::make_shared<Basis>(
+      Eigen::ArrayXd{{0.0, 0.0, 0.0, 0.4, 0.6, 1.0, 1.0, 1.0}}, 3)};
+  const std::shared_ptr<Basis> m_basisR{std::make_shared<Basis>(
+      Eigen::ArrayXd{{0.0, 0.0, 0.0, 0.0, 0.5, 1.0, 1.0, 1.0, 1.0}}, 4)};
+  const Spline m_splineL{m_basisL, Eigen::MatrixXd::Random(m_basisL->dim(), 2)};
+  const Spline m_splineR{m_basisR, Eigen::MatrixXd::Random(m_basisR->dim(), 2)};
+
+  const Eigen::ArrayXd m_points{Eigen::ArrayXd::LinSpaced(51, 0.0, 1.0)};
+
+  void TearDown() override {
+    TransformCache::global().setCapacity(0);
+    TransformCache::global().clear();
+    BasisPool::setEnabled(false);
+    BasisPool::global().clear();
+  }
+};
+
+/**
+ * @brief Test cached spline operations against uncached operations.
+ *
+ */
+TEST_F(TransformCacheTest, SplineOperations) {
+  const Spline sumGtr{m_splineL.add(m_splineR)};
+  const Spline prodGtr{m_splineL.prod(m_splineR)};
+  const Spline derivGtr{m_splineR.derivative(2)};
+
+  TransformCache::global().setCapacity(8);
+  for (int cRepeat{}; cRepeat < 3; ++cRepeat) {
+    expectAllClose(m_splineL.add(m_splineR)(m_points), sumGtr(m_points),
+                   1e-10);
+    expectAllClose(m_splineL.prod(m_splineR)(m_points), prodGtr(m_points),
+                   1e-10);
+    expectAllClose(m_splineR.derivative(2)(m_points), derivGtr(m_points),
+                   1e-10);
+  }
+
+  EXPECT_EQ(TransformCache::global().getMisses(), 3);
+  EXPECT_EQ(TransformCache::global().getHits(), 6);
+
+  // repeated operations have equal copies of the cached basis
+  EXPECT_NE(m_splineL.add(m_splineR).basis(),
+            m_splineL.add(m_splineR).basis());
+  EXPECT_TRUE(*m_splineL.add(m_splineR).basis() ==
+              *m_splineL.add(m_splineR).basis());
+}
+
+/**
+ * @brief Test modifying the basis of a result does not affect the cached
+ * transforms.
+ *
+ */
+TEST_F(TransformCacheTest, ModifyResultBasis) {
+  const Spline derivGtr{m_splineR.derivative()};
+  const Spline sumGtr{m_splineL.add(m_splineR)};
+  const Spline prodGtr{m_splineL.prod(m_splineR)};
+
+  TransformCache::global().setCapacity(16);
+  Spline sum{};
+  Spline prod{};
+  m_splineL.addInto(m_splineR, sum);
+  m_splineL.prodInto(m_splineR, prod);
+  for (const std::shared_ptr<Basis> &basis :
+       {m_splineR.derivative().basis(), m_splineL.add(m_splineR).basis(),
+        m_splineL.prod(m_splineR).basis(), sum.basis(), prod.basis()})
+    basis->setScale(5.0);
+
+  EXPECT_DOUBLE_EQ(m_splineR.derivative().basis()->getScale(), 1.0);
+  expectAllClose(m_splineR.derivative()(m_points), derivGtr(m_points), 1e-10);
+  expectAllClose(m_splineL.add(m_splineR)(m_points), sumGtr(m_points), 1e-10);
+  expectAllClose(m_splineL.prod(m_splineR)(m_points), prodGtr(m_points),
+                 1e-10);
+
+  // outputs with modified bases are assigned the unmodified basis again
+  m_splineL.addInto(m_splineR, sum);
+  m_splineL.prodInto(m_splineR, prod);
+  EXPECT_DOUBLE_EQ(sum.basis()->getScale(), 1.0);
+  EXPECT_DOUBLE_EQ(prod.basis()->getScale(), 1.0);
+  expectAllClose(sum(m_points), sumGtr(m_points), 1e-10);
+  expectAllClose(prod(m_points), prodGtr(m_points), 1e-10);
+  EXPECT_EQ(TransformCache::global().getMisses(), 3);
+}
+
+/**
+ * @brief Test cached operations obtain their basis from the enabled BasisPool.
+ *
+ */
+TEST_F(TransformCacheTest, PooledResults) {
+  TransformCache::global().setCapacity(8);
+  BasisPool::setEnabled(true);
+  Spline sum{};
+  for (int cRepeat{}; cRepeat < 2; ++cRepeat) {
+    EXPECT_EQ(m_splineR.derivative().basis(), m_splineR.derivative().basis());
+    EXPECT_EQ(m_splineL.add(m_splineR).basis(),
+              m_splineL.add(m_splineR).basis());
+    EXPECT_EQ(m_splineL.prod(m_splineR).basis(),
+              m_splineL.prod(m_splineR).basis());
+    m_splineL.addInto(m_splineR, sum);
+    EXPECT_EQ(sum.basis(), m_splineL.add(m_splineR).basis());
+  }
+  EXPECT_EQ(TransformCache::global().getMisses(), 3);
+}
+
+/**
+ * @brief Test eviction of the least recently used transform.
+ *
+ */
+TEST_F(TransformCacheTest, EvictLeastRecent) {
+  TransformCache cache{2};
+  const Basis basisOther{Eigen::ArrayXd{{0.0, 0.0, 1.0, 1.0}}, 2};
+
+  const auto transformL{cache.derivative(*m_basisL)};
+  cache.derivative(*m_basisR);
+  EXPECT_EQ(cache.derivative(*m_basisL), transformL);
+
+  // evicts derivative of right basis as least recently used
+  cache.derivative(basisOther);
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_EQ(cache.derivative(*m_basisL), transformL);
+  EXPECT_EQ(cache.getMisses(), 3);
+  cache.derivative(*m_basisR);
+  EXPECT_EQ(cache.getMisses(), 4);
+
+  // keys distinguish operation parameters and copied operands
+  EXPECT_NE(cache.derivative(*m_basisL, 2), transformL);
+  Basis basisMod{*m_basisL};
+  basisMod.setScale(2.0);
+  EXPECT_NE(cache.derivative(basisMod), transformL);
+
+  cache.setCapacity(1);
+  EXPECT_EQ(cache.size(), 1);
+}
+
+/**
+ * @brief Test derivatives cache only their basis, with unit scale following
+ * the first derivative.
+ *
+ */
+TEST_F(TransformCacheTest, DerivativeBasisOnly) {
+  TransformCache cache{4};
+  Basis basisScaled{*m_basisR};
+  basisScaled.setScale(0.5);
+
+  const auto transform{cache.derivative(basisScaled, 2)};
+  Basis basisGtr{};
+  basisScaled.derivative(basisGtr, 2);
+  EXPECT_TRUE(transform->matrices.empty());
+  EXPECT_TRUE(*transform->basis == basisGtr);
+  EXPECT_TRUE(*cache.derivative(basisScaled, 0)->basis == basisScaled);
+
+  // cached derivatives of a scaled basis coincide with uncached ones
+  const Spline spline{std::make_shared<Basis>(basisScaled),
+                      m_splineR.getCoefficients()};
+  const Spline derivGtr{spline.derivative(3)};
+  TransformCache::global().setCapacity(4);
+  for (int cRepeat{}; cRepeat < 2; ++cRepeat)
+    expectAllClose(spline.derivative(3)(m_points), derivGtr(m_points), 1e-10);
+  EXPECT_EQ(TransformCache::global().getHits(), 1);
+}
+
+/**
+ * @brief Test the memory limit evicts transforms and rejects transforms
+ * larger than the limit.
+ *
+ */
+TEST_F(TransformCacheTest, MaxBytes) {
+  TransformCache cache{16};
+  cache.prod(*m_basisL, *m_basisR);
+  const size_t bytesProd{cache.getBytes()};
+  cache.derivative(*m_basisR);
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_GT(cache.getBytes(), bytesProd);
+
+  // least recently used product is evicted
+  cache.setMaxBytes(cache.getBytes() - 1);
+  EXPECT_EQ(cache.size(), 1);
+  EXPECT_LT(cache.getBytes(), bytesProd);
+
+  // product exceeding the limit is not cached
+  cache.setMaxBytes(bytesProd - 1);
+  cache.prod(*m_basisL, *m_basisR);
+  EXPECT_EQ(cache.size(), 1);
+  EXPECT_LE(cache.getBytes(), cache.getMaxBytes());
+
+  cache.clear();
+  EXPECT_EQ(cache.getBytes(), 0);
+}
+
+}; // namespace Internal
+}; // namespace BasisSplines
+
+int main(int argc, char **argv) {
+  std::srand(0);
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}